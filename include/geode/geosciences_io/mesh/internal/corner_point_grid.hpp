@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <absl/types/span.h>
+
+#include <geode/basic/pimpl.hpp>
+
+#include <geode/geometry/point.hpp>
+
+#include <geode/mesh/core/mesh_id.hpp>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+
+namespace geode
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( HybridSolid );
+    FORWARD_DECLARATION_DIMENSION_CLASS( RegularGrid );
+    ALIAS_3D( HybridSolid );
+    ALIAS_3D( RegularGrid );
+} // namespace geode
+
+namespace geode
+{
+    namespace internal
+    {
+        /*!
+         * Corner-point grid stored as its Eclipse arrays: the pillars
+         * (COORD), the depths of the 8 corners of each cell (ZCORN) and the
+         * active cells (ACTNUM). Cell corners are computed on demand and an
+         * explicit HybridSolid is only built when requested.
+         * Cells are indexed with i varying fastest, then j, then k.
+         */
+        class opengeode_geosciencesio_mesh_api CornerPointGrid
+        {
+            OPENGEODE_DISABLE_COPY( CornerPointGrid );
+
+        public:
+            CornerPointGrid( index_t nx, index_t ny, index_t nz );
+            CornerPointGrid( CornerPointGrid&& other ) noexcept;
+            CornerPointGrid& operator=( CornerPointGrid&& other ) noexcept;
+            ~CornerPointGrid();
+
+            static std::string_view grid_coordinates_attribute_name()
+            {
+                static constexpr auto NAME = "grid_coordinates";
+                return NAME;
+            }
+
+            index_t nb_cells_in_direction( local_index_t direction ) const;
+
+            index_t nb_cells() const;
+
+            index_t nb_pillars() const;
+
+            index_t cell_index(
+                const std::array< index_t, 3 >& grid_coordinates ) const;
+
+            std::array< index_t, 3 > cell_grid_coordinates(
+                index_t cell ) const;
+
+            /*!
+             * Top and bottom points of each pillar, i.e. 6 values per pillar
+             * with i varying fastest, as in the COORD keyword.
+             */
+            absl::Span< const double > pillar_coordinates() const;
+
+            absl::Span< double > modifiable_pillar_coordinates();
+
+            /*!
+             * Depths of the cell corners, i.e. 8 values per cell laid out as
+             * in the ZCORN keyword.
+             */
+            absl::Span< const double > corner_depths() const;
+
+            absl::Span< double > modifiable_corner_depths();
+
+            /*!
+             * Returns true if the active cells were set, i.e. if an ACTNUM
+             * array was given. Otherwise, all the cells are active.
+             */
+            bool defines_active_cells() const;
+
+            bool is_cell_active( index_t cell ) const;
+
+            index_t nb_active_cells() const;
+
+            void set_active_cells( std::vector< bool > is_active );
+
+            /*!
+             * Stores one value per cell for the given property name.
+             */
+            void add_cell_property(
+                std::string_view name, std::vector< double > values );
+
+            std::vector< std::string_view > cell_property_names() const;
+
+            absl::Span< const double > cell_property(
+                std::string_view name ) const;
+
+            /*!
+             * Returns the 8 corners of the cell, ordered as the vertices of
+             * the hexahedra created by hybrid_solid().
+             */
+            std::array< Point3D, 8 > cell_corners( index_t cell ) const;
+
+            /*!
+             * Builds the explicit mesh of the grid: one hexahedron per cell,
+             * corners shared between cells being merged. Each polyhedron
+             * stores its (i,j,k) coordinates in the
+             * grid_coordinates_attribute_name() attribute and cell properties
+             * become polyhedron attributes.
+             * @param[in] skip_inactive_cells Do not create the inactive cells.
+             */
+            std::unique_ptr< HybridSolid3D > hybrid_solid(
+                const MeshImpl& impl, bool skip_inactive_cells ) const;
+
+        private:
+            IMPLEMENTATION_MEMBER( impl_ );
+        };
+
+        /*!
+         * Builds the grid of a HybridSolid created by
+         * CornerPointGrid::hybrid_solid(), using the grid coordinates and
+         * the ACTNUM attributes of its polyhedra. Missing cells are inactive.
+         * Polyhedron double attributes become cell properties.
+         */
+        CornerPointGrid opengeode_geosciencesio_mesh_api
+            corner_point_grid_from_hybrid_solid( const HybridSolid3D& solid );
+
+        /*!
+         * Builds the grid with straight pillars matching a RegularGrid.
+         * Cell double attributes become cell properties. Pillars follow the
+         * third grid direction, which must not be horizontal.
+         */
+        CornerPointGrid opengeode_geosciencesio_mesh_api
+            corner_point_grid_from_regular_grid( const RegularGrid3D& grid );
+    } // namespace internal
+} // namespace geode
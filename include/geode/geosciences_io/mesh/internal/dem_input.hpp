@@ -24,6 +24,8 @@
 #pragma once
 
 #include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/gdal_configuration.hpp>
+#include <geode/geosciences_io/mesh/internal/raster_level.hpp>
 
 #include <geode/mesh/io/polygonal_surface_input.hpp>
 
@@ -31,6 +33,20 @@ namespace geode
 {
     namespace internal
     {
+        struct DEMInputOptions
+        {
+            /*!
+             * Resolution of the read raster, the native one by default.
+             */
+            RasterLevelOptions level;
+
+            /*!
+             * GDAL settings applied during the read, on top of the library
+             * ones.
+             */
+            GDALConfiguration gdal;
+        };
+
         class DEMInput final : public PolygonalSurfaceInput< 3 >
         {
         public:
@@ -39,6 +55,12 @@ namespace geode
             {
             }
 
+            DEMInput(
+                std::string_view filename, const DEMInputOptions& options )
+                : PolygonalSurfaceInput< 3 >( filename ), options_( options )
+            {
+            }
+
             static std::string_view extension()
             {
                 static constexpr auto EXT = "dem";
@@ -56,6 +78,9 @@ namespace geode
             }
 
             Percentage is_loadable() const final;
+
+        private:
+            DEMInputOptions options_;
         };
     } // namespace internal
 } // namespace geode
\ No newline at end of file
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#pragma once
+
+#include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/gdal_configuration.hpp>
+#include <geode/geosciences_io/mesh/internal/raster_level.hpp>
+
+#include <geode/mesh/io/triangulated_surface_input.hpp>
+
+namespace geode
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( TriangulatedSurface );
+    ALIAS_3D( TriangulatedSurface );
+} // namespace geode
+
+namespace geode
+{
+    namespace internal
+    {
+        struct DEMTINInputOptions
+        {
+            /*!
+             * Largest vertical distance between a raster pixel and the
+             * triangulated surface.
+             */
+            double max_vertical_error{ 0 };
+
+            /*!
+             * Resolution of the read raster, the native one by default.
+             */
+            RasterLevelOptions level;
+
+            /*!
+             * GDAL settings applied during the read, on top of the library
+             * ones.
+             */
+            GDALConfiguration gdal;
+        };
+
+        /*!
+         * Builds an adaptive triangulation of a DEM raster: triangles are
+         * refined until every valid pixel lies within the maximal vertical
+         * error of the surface. Pixels without data are left as holes.
+         */
+        class DEMTINInput final : public TriangulatedSurfaceInput< 3 >
+        {
+        public:
+            explicit DEMTINInput( std::string_view filename )
+                : TriangulatedSurfaceInput< 3 >( filename )
+            {
+            }
+
+            DEMTINInput(
+                std::string_view filename, const DEMTINInputOptions& options )
+                : TriangulatedSurfaceInput< 3 >( filename ), options_( options )
+            {
+            }
+
+            static std::string_view extension()
+            {
+                static constexpr auto EXT = "dem";
+                return EXT;
+            }
+
+            std::unique_ptr< TriangulatedSurface3D > read(
+                const MeshImpl& impl ) final;
+
+            AdditionalFiles additional_files() const final;
+
+            index_t object_priority() const final
+            {
+                return 0;
+            }
+
+            Percentage is_loadable() const final;
+
+        private:
+            DEMTINInputOptions options_;
+        };
+    } // namespace internal
+} // namespace geode
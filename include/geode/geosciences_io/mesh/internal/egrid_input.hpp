@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <geode/mesh/io/hybrid_solid_input.hpp>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/corner_point_grid.hpp>
+
+namespace geode
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( HybridSolid );
+    ALIAS_3D( HybridSolid );
+} // namespace geode
+
+namespace geode
+{
+    namespace internal
+    {
+        /*!
+         * Reader of binary Eclipse grids (big-endian unformatted EGRID file).
+         * Cell properties are read from the INIT file next to it, if any.
+         */
+        class EGRIDInput : public HybridSolidInput< 3 >
+        {
+        public:
+            explicit EGRIDInput( std::string_view filename )
+                : HybridSolidInput< 3 >( filename )
+            {
+            }
+
+            static std::string_view extension()
+            {
+                static constexpr auto EXT = "egrid";
+                return EXT;
+            }
+
+            std::unique_ptr< HybridSolid3D > read( const MeshImpl& impl ) final;
+
+            /*!
+             * Reads the grid without building its explicit mesh.
+             */
+            CornerPointGrid read_corner_point_grid() const;
+
+            AdditionalFiles additional_files() const final;
+
+            index_t object_priority() const final
+            {
+                return 0;
+            }
+
+            Percentage is_loadable() const final;
+        };
+    } // namespace internal
+} // namespace geode
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#pragma once
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+
+namespace geode
+{
+    namespace internal
+    {
+        /*!
+         * GDAL settings used by the raster and vector readers.
+         *
+         * num_threads speeds up the decoding of compressed blocks (DEFLATE,
+         * ZSTD, LZW, JPEG, ...) of tiled GeoTIFF and COG files, which benefits
+         * the DEM, PolyTIFF and GeoTIFF readers reading whole rasters or large
+         * windows. cache_max benefits the windowed and coarser level reads and
+         * the GEOTIFFBandReader, which revisit the same blocks. The SHP reader
+         * barely benefits from either, shapefiles being uncompressed vectors.
+         */
+        struct GDALConfiguration
+        {
+            /*!
+             * GDAL_NUM_THREADS value: a number of threads or "ALL_CPUS".
+             */
+            std::optional< std::string > num_threads;
+
+            /*!
+             * Size of the GDAL block cache in megabytes (GDAL_CACHEMAX).
+             */
+            std::optional< index_t > cache_max;
+
+            /*!
+             * Other GDAL configuration options, as (key, value) pairs, e.g.
+             * GDAL_DISABLE_READDIR_ON_OPEN or VSI_CACHE.
+             */
+            std::vector< std::pair< std::string, std::string > > options;
+        };
+
+        /*!
+         * Ensures the GDAL drivers used by the readers and writers of this
+         * library (GTiff, ESRI Shapefile and the DEM drivers) are registered,
+         * once per process. If one of them is missing, every GDAL driver is
+         * registered. Called before opening any GDAL dataset.
+         */
+        void opengeode_geosciencesio_mesh_api register_gdal_drivers();
+
+        /*!
+         * Registers every GDAL driver, for rasters in other formats than the
+         * ones handled by register_gdal_drivers.
+         */
+        void opengeode_geosciencesio_mesh_api register_all_gdal_drivers();
+
+        /*!
+         * Applies the configuration to the whole process, for all the
+         * following reads. Unset fields keep their current value.
+         */
+        void opengeode_geosciencesio_mesh_api set_gdal_configuration(
+            const GDALConfiguration& configuration );
+
+        /*!
+         * Applies a configuration to the reads done by the current thread
+         * during the lifetime of this object, previous values being restored
+         * on destruction. Since the block cache is shared by the process, it
+         * is only grown to cache_max while at least one scope requests it.
+         */
+        class opengeode_geosciencesio_mesh_api ScopedGDALConfiguration
+        {
+        public:
+            explicit ScopedGDALConfiguration(
+                const GDALConfiguration& configuration );
+            ~ScopedGDALConfiguration();
+
+            OPENGEODE_DISABLE_COPY_AND_MOVE( ScopedGDALConfiguration );
+
+        private:
+            std::vector<
+                std::pair< std::string, std::optional< std::string > > >
+                previous_options_;
+            std::optional< index_t > cache_max_;
+        };
+    } // namespace internal
+} // namespace geode
@@ -23,7 +23,14 @@
 
 #pragma once
 
+#include <string>
+
+#include <geode/basic/pimpl.hpp>
+
 #include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/gdal_configuration.hpp>
+#include <geode/geosciences_io/mesh/internal/grid_window.hpp>
+#include <geode/geosciences_io/mesh/internal/raster_level.hpp>
 
 #include <geode/mesh/io/light_regular_grid_input.hpp>
 
@@ -31,6 +38,39 @@ namespace geode
 {
     namespace internal
     {
+        struct GEOTIFFInputOptions
+        {
+            /*!
+             * Part of the raster to read, the whole raster by default.
+             */
+            GridWindowOptions< 2 > window;
+
+            /*!
+             * Resolution of the read raster, the native one by default. The
+             * window cells are coarsened accordingly.
+             */
+            RasterLevelOptions level;
+
+            /*!
+             * Read each band into a cell attribute typed as the band values,
+             * named by GEOTIFFBandReader::attribute_name, instead of RGB
+             * colors.
+             */
+            bool band_attributes{ false };
+
+            /*!
+             * Only read the grid geometry, band values being read on demand
+             * with a GEOTIFFBandReader. Takes precedence over band_attributes.
+             */
+            bool lazy_bands{ false };
+
+            /*!
+             * GDAL settings applied during the read, on top of the library
+             * ones.
+             */
+            GDALConfiguration gdal;
+        };
+
         class GEOTIFFInput final : public LightRegularGridInput2D
         {
         public:
@@ -39,6 +79,12 @@ namespace geode
             {
             }
 
+            GEOTIFFInput(
+                std::string_view filename, const GEOTIFFInputOptions& options )
+                : LightRegularGridInput2D( filename ), options_( options )
+            {
+            }
+
             static std::vector< std::string > extensions()
             {
                 static const std::vector< std::string > extensions{ "tiff",
@@ -77,6 +123,46 @@ namespace geode
             {
                 return 1;
             }
+
+        private:
+            GEOTIFFInputOptions options_;
+        };
+
+        /*!
+         * Reads the band values of a GeoTIFF file on demand, for the cells of
+         * the grid read by GEOTIFFInput with the same options. Single values
+         * go through the GDAL block cache, so only the raster blocks
+         * containing the requested cells are read from the file. At a
+         * coarser level, single values are read from the GDAL overview of
+         * the level size and value() throws if there is none, materialize()
+         * resampling the band as GEOTIFFInput does. The GDAL configuration
+         * of the options applies to all its reads, the block cache being
+         * kept at least at cache_max during its lifetime.
+         */
+        class opengeode_geosciencesio_mesh_api GEOTIFFBandReader
+        {
+            OPENGEODE_DISABLE_COPY( GEOTIFFBandReader );
+
+        public:
+            GEOTIFFBandReader( std::string_view filename,
+                const GEOTIFFInputOptions& options = {} );
+            GEOTIFFBandReader( GEOTIFFBandReader&& other ) noexcept;
+            ~GEOTIFFBandReader();
+
+            static std::string attribute_name( index_t band );
+
+            index_t nb_bands() const;
+
+            double value( index_t band, index_t cell ) const;
+
+            /*!
+             * Reads the whole band into a cell attribute of the grid, typed
+             * as the band values.
+             */
+            void materialize( index_t band, LightRegularGrid2D& grid ) const;
+
+        private:
+            IMPLEMENTATION_MEMBER( impl_ );
         };
     } // namespace internal
 } // namespace geode
\ No newline at end of file
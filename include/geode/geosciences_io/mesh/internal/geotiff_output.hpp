@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <geode/mesh/io/light_regular_grid_output.hpp>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+
+namespace geode
+{
+    namespace internal
+    {
+        struct GEOTIFFOutputOptions
+        {
+            /*!
+             * GDAL compression of the tiles: DEFLATE, ZSTD, LZW or NONE.
+             */
+            std::string compression{ "DEFLATE" };
+
+            /*!
+             * Number of pixels along each side of the tiles, must be a
+             * multiple of 16. Other sizes are rejected with an exception.
+             */
+            index_t tile_size{ 256 };
+
+            /*!
+             * NoData value of the bands. If unset, the bands have no NoData
+             * value and every pixel is valid data.
+             */
+            std::optional< double > no_data_value;
+
+            /*!
+             * Decimation factors of the overviews stored in the file.
+             */
+            std::vector< index_t > overviews{ 2, 4, 8, 16 };
+
+            /*!
+             * GDAL resampling method used to compute the overviews.
+             */
+            std::string overview_resampling{ "AVERAGE" };
+
+            /*!
+             * Write the grid vertex attributes, as pixels centered on the
+             * vertices, instead of the cell attributes.
+             */
+            bool vertex_attributes{ false };
+        };
+
+        /*!
+         * Writes each item of the genericable cell (or vertex) attributes of
+         * the grid in its own band of a tiled and compressed GeoTIFF, with
+         * the grid georeferencing.
+         */
+        class GEOTIFFOutput final : public LightRegularGridOutput< 2 >
+        {
+        public:
+            explicit GEOTIFFOutput( std::string_view filename )
+                : LightRegularGridOutput< 2 >( filename )
+            {
+            }
+
+            GEOTIFFOutput(
+                std::string_view filename, GEOTIFFOutputOptions options )
+                : LightRegularGridOutput< 2 >( filename ),
+                  options_( std::move( options ) )
+            {
+            }
+
+            static std::vector< std::string > extensions()
+            {
+                static const std::vector< std::string > extensions{ "tiff",
+                    "tif" };
+                return extensions;
+            }
+
+            std::vector< std::string > write(
+                const LightRegularGrid2D& grid ) const final;
+
+        private:
+            GEOTIFFOutputOptions options_;
+        };
+    } // namespace internal
+} // namespace geode
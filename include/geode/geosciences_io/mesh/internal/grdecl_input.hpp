@@ -25,6 +25,7 @@
 #include <geode/mesh/io/hybrid_solid_input.hpp>
 
 #include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/corner_point_grid.hpp>
 
 namespace geode
 {
@@ -36,6 +37,15 @@ namespace geode
 {
     namespace internal
     {
+        struct GRDECLInputOptions
+        {
+            /*!
+             * Do not create the cells flagged as inactive by the ACTNUM
+             * keyword, nor their corner points.
+             */
+            bool skip_inactive_cells{ false };
+        };
+
         class GRDECLInput : public HybridSolidInput< 3 >
         {
         public:
@@ -44,14 +54,30 @@ namespace geode
             {
             }
 
+            GRDECLInput(
+                std::string_view filename, const GRDECLInputOptions& options )
+                : HybridSolidInput< 3 >( filename ), options_( options )
+            {
+            }
+
             static std::string_view extension()
             {
                 static constexpr auto EXT = "grdecl";
                 return EXT;
             }
 
+            static std::string_view grid_coordinates_attribute_name()
+            {
+                return CornerPointGrid::grid_coordinates_attribute_name();
+            }
+
             std::unique_ptr< HybridSolid3D > read( const MeshImpl& impl ) final;
 
+            /*!
+             * Reads the grid without building its explicit mesh.
+             */
+            CornerPointGrid read_corner_point_grid() const;
+
             AdditionalFiles additional_files() const final
             {
                 return {};
@@ -63,6 +89,9 @@ namespace geode
             }
 
             Percentage is_loadable() const final;
+
+        private:
+            GRDECLInputOptions options_;
         };
     } // namespace internal
 } // namespace geode
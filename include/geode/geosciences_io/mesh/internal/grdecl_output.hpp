@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <geode/mesh/io/hybrid_solid_output.hpp>
+#include <geode/mesh/io/regular_grid_output.hpp>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/corner_point_grid.hpp>
+
+namespace geode
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( HybridSolid );
+    FORWARD_DECLARATION_DIMENSION_CLASS( RegularGrid );
+    ALIAS_3D( HybridSolid );
+    ALIAS_3D( RegularGrid );
+} // namespace geode
+
+namespace geode
+{
+    namespace internal
+    {
+        struct GRDECLOutputOptions
+        {
+            /*!
+             * Names of the cell properties to write. All of them are
+             * written if empty. Names are written as keywords: they are
+             * upper-cased, characters other than letters and digits become
+             * '_' and they are truncated to 8 characters, a number keeping
+             * them unique. Renamed properties are logged as warnings.
+             */
+            std::vector< std::string > properties;
+
+            /*!
+             * Write each keyword in its own file next to the main file,
+             * which only refers to them with INCLUDE keywords.
+             */
+            bool use_include_files{ false };
+        };
+
+        /*!
+         * Writes the SPECGRID, COORD, ZCORN and ACTNUM keywords of the grid,
+         * and its cell properties. Returns the written files.
+         */
+        std::vector< std::string > opengeode_geosciencesio_mesh_api
+            write_grdecl( const CornerPointGrid& grid,
+                std::string_view filename,
+                const GRDECLOutputOptions& options );
+
+        class GRDECLOutput final : public HybridSolidOutput< 3 >
+        {
+        public:
+            explicit GRDECLOutput( std::string_view filename )
+                : HybridSolidOutput< 3 >( filename )
+            {
+            }
+
+            GRDECLOutput(
+                std::string_view filename, GRDECLOutputOptions options )
+                : HybridSolidOutput< 3 >( filename ),
+                  options_( std::move( options ) )
+            {
+            }
+
+            static std::string_view extension()
+            {
+                static constexpr auto EXT = "grdecl";
+                return EXT;
+            }
+
+            std::vector< std::string > write(
+                const HybridSolid3D& solid ) const final;
+
+        private:
+            GRDECLOutputOptions options_;
+        };
+
+        class RegularGridGRDECLOutput final : public RegularGridOutput< 3 >
+        {
+        public:
+            explicit RegularGridGRDECLOutput( std::string_view filename )
+                : RegularGridOutput< 3 >( filename )
+            {
+            }
+
+            RegularGridGRDECLOutput(
+                std::string_view filename, GRDECLOutputOptions options )
+                : RegularGridOutput< 3 >( filename ),
+                  options_( std::move( options ) )
+            {
+            }
+
+            static std::string_view extension()
+            {
+                return GRDECLOutput::extension();
+            }
+
+            std::vector< std::string > write(
+                const RegularGrid3D& grid ) const final;
+
+        private:
+            GRDECLOutputOptions options_;
+        };
+    } // namespace internal
+} // namespace geode
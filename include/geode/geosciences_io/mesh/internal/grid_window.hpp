@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+#include <geode/basic/range.hpp>
+
+#include <geode/geometry/bounding_box.hpp>
+#include <geode/geometry/point.hpp>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+
+namespace geode
+{
+    namespace internal
+    {
+        template < index_t dimension >
+        struct GridWindowOptions
+        {
+            /*!
+             * Indices of the first cell to read and indices past the last
+             * cell to read in each direction.
+             */
+            std::optional< std::array< std::array< index_t, dimension >, 2 > >
+                cells;
+
+            /*!
+             * Box in world coordinates containing the centers of the cells to
+             * read. Ignored if cells are given.
+             */
+            std::optional< BoundingBox< dimension > > box;
+
+            /*!
+             * Each read cell covers stride cells of the file in each
+             * direction and takes the value of the middle one. Only complete
+             * groups of stride cells are read: the last file cells of a
+             * window whose size is not a multiple of stride are dropped,
+             * e.g. a 100 x 50 window read with a stride of 4 gives
+             * 25 x 12 cells, the last 2 rows being ignored.
+             */
+            index_t stride{ 1 };
+        };
+
+        /*!
+         * Cells of a grid file selected by GridWindowOptions. Cell i of the
+         * window covers the file cells from begin + i * stride to
+         * begin + ( i + 1 ) * stride. A trailing partial group of file cells
+         * is not part of the window, so that every window cell covers
+         * stride file cells.
+         */
+        template < index_t dimension >
+        class GridWindow
+        {
+        public:
+            /*!
+             * @param cell_coordinates Returns the coordinates of a point in
+             * the file grid, where cell i spans from i to i + 1.
+             */
+            template < typename CellCoordinates >
+            GridWindow( const GridWindowOptions< dimension >& options,
+                const std::array< index_t, dimension >& cells_number,
+                CellCoordinates&& cell_coordinates )
+                : begin_(), end_( cells_number ), stride_( options.stride )
+            {
+                begin_.fill( 0 );
+                if( options.cells )
+                {
+                    begin_ = options.cells->front();
+                    end_ = options.cells->back();
+                }
+                else if( options.box )
+                {
+                    set_box_cells( options.box.value(), cells_number,
+                        cell_coordinates );
+                }
+                for( const auto d : LRange{ dimension } )
+                {
+                    end_[d] = std::min( end_[d], cells_number[d] );
+                    OpenGeodeGeosciencesIOMeshException::check_exception(
+                        stride_ > 0 && begin_[d] + stride_ <= end_[d],
+                        nullptr, OpenGeodeException::TYPE::data,
+                        "[GridWindow] Window has no cell in direction ", d );
+                }
+            }
+
+            bool is_whole_grid(
+                const std::array< index_t, dimension >& cells_number ) const
+            {
+                for( const auto d : LRange{ dimension } )
+                {
+                    if( begin_[d] != 0 || end_[d] != cells_number[d] )
+                    {
+                        return false;
+                    }
+                }
+                return stride_ == 1;
+            }
+
+            index_t begin( local_index_t direction ) const
+            {
+                return begin_[direction];
+            }
+
+            index_t stride() const
+            {
+                return stride_;
+            }
+
+            index_t nb_cells( local_index_t direction ) const
+            {
+                return ( end_[direction] - begin_[direction] ) / stride_;
+            }
+
+            std::array< index_t, dimension > cells_number() const
+            {
+                std::array< index_t, dimension > result;
+                for( const auto d : LRange{ dimension } )
+                {
+                    result[d] = nb_cells( d );
+                }
+                return result;
+            }
+
+            /*!
+             * Index in the file grid of the cell giving its value to the
+             * window cell.
+             */
+            index_t file_cell( local_index_t direction, index_t cell ) const
+            {
+                return begin_[direction] + cell * stride_ + stride_ / 2;
+            }
+
+            /*!
+             * Indices in the window of the cell taking its value from the
+             * given file cell, if any.
+             */
+            std::optional< std::array< index_t, dimension > > window_cell(
+                const std::array< index_t, dimension >& file_cell ) const
+            {
+                std::array< index_t, dimension > result;
+                for( const auto d : LRange{ dimension } )
+                {
+                    const auto first = begin_[d] + stride_ / 2;
+                    if( file_cell[d] < first
+                        || ( file_cell[d] - first ) % stride_ != 0 )
+                    {
+                        return std::nullopt;
+                    }
+                    result[d] = ( file_cell[d] - first ) / stride_;
+                    if( result[d] >= nb_cells( d ) )
+                    {
+                        return std::nullopt;
+                    }
+                }
+                return result;
+            }
+
+        private:
+            template < typename CellCoordinates >
+            void set_box_cells( const BoundingBox< dimension >& box,
+                const std::array< index_t, dimension >& cells_number,
+                CellCoordinates& cell_coordinates )
+            {
+                std::array< double, dimension > min;
+                std::array< double, dimension > max;
+                min.fill( std::numeric_limits< double >::max() );
+                max.fill( std::numeric_limits< double >::lowest() );
+                for( const auto corner : Range{ 1u << dimension } )
+                {
+                    Point< dimension > point;
+                    for( const auto d : LRange{ dimension } )
+                    {
+                        point.set_value( d, ( corner >> d ) & 1
+                                                ? box.max().value( d )
+                                                : box.min().value( d ) );
+                    }
+                    const auto coordinates = cell_coordinates( point );
+                    for( const auto d : LRange{ dimension } )
+                    {
+                        min[d] = std::min( min[d], coordinates[d] );
+                        max[d] = std::max( max[d], coordinates[d] );
+                    }
+                }
+                for( const auto d : LRange{ dimension } )
+                {
+                    const auto first = std::ceil( min[d] - 0.5 );
+                    const auto last = std::floor( max[d] - 0.5 );
+                    const double nb_cells = cells_number[d];
+                    begin_[d] = static_cast< index_t >(
+                        std::clamp( first, 0., nb_cells ) );
+                    end_[d] = static_cast< index_t >(
+                        std::clamp( last + 1, 0., nb_cells ) );
+                }
+            }
+
+        private:
+            std::array< index_t, dimension > begin_;
+            std::array< index_t, dimension > end_;
+            index_t stride_;
+        };
+    } // namespace internal
+} // namespace geode
@@ -24,6 +24,8 @@
 #pragma once
 
 #include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/gdal_configuration.hpp>
+#include <geode/geosciences_io/mesh/internal/raster_level.hpp>
 
 #include <geode/mesh/io/polygonal_surface_input.hpp>
 
@@ -37,6 +39,20 @@ namespace geode
 {
     namespace internal
     {
+        struct PolyTIFFInputOptions
+        {
+            /*!
+             * Resolution of the read raster, the native one by default.
+             */
+            RasterLevelOptions level;
+
+            /*!
+             * GDAL settings applied during the read, on top of the library
+             * ones.
+             */
+            GDALConfiguration gdal;
+        };
+
         class PolyTIFFInput final : public PolygonalSurfaceInput3D
         {
         public:
@@ -45,6 +61,12 @@ namespace geode
             {
             }
 
+            PolyTIFFInput(
+                std::string_view filename, const PolyTIFFInputOptions& options )
+                : PolygonalSurfaceInput3D( filename ), options_( options )
+            {
+            }
+
             static std::vector< std::string > extensions()
             {
                 static const std::vector< std::string > extensions{ "tiff",
@@ -63,6 +85,9 @@ namespace geode
             }
 
             Percentage is_loadable() const final;
+
+        private:
+            PolyTIFFInputOptions options_;
         };
     } // namespace internal
 } // namespace geode
\ No newline at end of file
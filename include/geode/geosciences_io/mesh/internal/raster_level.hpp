@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#pragma once
+
+#include <array>
+#include <optional>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+
+class GDALDataset;
+
+namespace geode
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( CoordinateSystem );
+    ALIAS_2D( CoordinateSystem );
+} // namespace geode
+
+namespace geode
+{
+    namespace internal
+    {
+        struct RasterLevelOptions
+        {
+            /*!
+             * GDAL overview to read, 0 being the finest one. Takes precedence
+             * over the resolution.
+             */
+            std::optional< index_t > overview;
+
+            /*!
+             * Target pixel size in the raster coordinate system units. The
+             * raster is read with the largest number of pixels whose size is
+             * not smaller than this one.
+             */
+            std::optional< double > resolution;
+
+            bool is_native() const
+            {
+                return !overview && !resolution;
+            }
+        };
+
+        /*!
+         * Number of pixels to read in each direction for the requested
+         * level. When reading the whole raster into a buffer of this size,
+         * GDAL uses the matching overview if any and resamples the raster
+         * otherwise.
+         */
+        std::array< index_t, 2 > opengeode_geosciencesio_mesh_api
+            raster_level_size( GDALDataset& dataset,
+                const CoordinateSystem2D& coordinate_system,
+                const RasterLevelOptions& options );
+
+        /*!
+         * Coordinate system of the raster read with level_size pixels.
+         */
+        CoordinateSystem2D opengeode_geosciencesio_mesh_api
+            raster_level_coordinate_system(
+                const CoordinateSystem2D& coordinate_system,
+                const std::array< index_t, 2 >& raster_size,
+                const std::array< index_t, 2 >& level_size );
+    } // namespace internal
+} // namespace geode
@@ -23,11 +23,18 @@
 
 #pragma once
 
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <geode/basic/attribute.hpp>
 #include <geode/basic/input.hpp>
+#include <geode/basic/pimpl.hpp>
 
 #include <geode/mesh/io/regular_grid_input.hpp>
 
 #include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/grid_window.hpp>
 
 namespace geode
 {
@@ -39,6 +46,20 @@ namespace geode
 {
     namespace internal
     {
+        struct VOInputOptions
+        {
+            /*!
+             * Read the cell properties with the grid. Otherwise, they can be
+             * loaded on demand with a VoxetPropertyLoader.
+             */
+            bool load_properties{ true };
+
+            /*!
+             * Part of the grid to read, the whole grid by default.
+             */
+            GridWindowOptions< 3 > window;
+        };
+
         class VOInput : public RegularGridInput< 3 >
         {
         public:
@@ -47,6 +68,11 @@ namespace geode
             {
             }
 
+            VOInput( std::string_view filename, const VOInputOptions& options )
+                : RegularGridInput< 3 >( filename ), options_( options )
+            {
+            }
+
             static std::string_view extension()
             {
                 static constexpr auto EXT = "vo";
@@ -63,6 +89,57 @@ namespace geode
             }
 
             Percentage is_loadable() const final;
+
+        private:
+            VOInputOptions options_;
+        };
+
+        /*!
+         * Loads the properties of a Voxet file into the cell attributes of
+         * its grid when they are first accessed. When the loaded properties
+         * exceed the memory budget, the least recently accessed ones are
+         * removed from the grid. The grid must outlive the loader.
+         * Methods may be called concurrently: loads and evictions are
+         * serialized. A returned attribute stays valid after its eviction,
+         * but the grid cell attributes must not be modified elsewhere while
+         * the loader is used from several threads.
+         */
+        class opengeode_geosciencesio_mesh_api VoxetPropertyLoader
+        {
+            OPENGEODE_DISABLE_COPY( VoxetPropertyLoader );
+
+        public:
+            /*!
+             * @param options Options used to read the grid, to load
+             * properties on the same window.
+             */
+            VoxetPropertyLoader( std::string_view filename,
+                RegularGrid3D& grid,
+                const VOInputOptions& options = {} );
+            VoxetPropertyLoader( VoxetPropertyLoader&& other ) noexcept;
+            ~VoxetPropertyLoader();
+
+            std::vector< std::string_view > property_names() const;
+
+            bool is_property_loaded( std::string_view name ) const;
+
+            /*!
+             * Returns the cell attribute of the property, reading it from
+             * the data files if it is not loaded.
+             */
+            std::shared_ptr< ReadOnlyAttribute< double > > property(
+                std::string_view name );
+
+            void unload_property( std::string_view name );
+
+            /*!
+             * Sets the maximum size in bytes of the loaded properties. The
+             * last accessed property is always kept.
+             */
+            void set_memory_budget( std::size_t budget );
+
+        private:
+            IMPLEMENTATION_MEMBER( impl_ );
         };
     } // namespace internal
 } // namespace geode
\ No newline at end of file
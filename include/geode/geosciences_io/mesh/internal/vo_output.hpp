@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <geode/mesh/io/regular_grid_output.hpp>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+
+namespace geode
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( RegularGrid );
+    ALIAS_3D( RegularGrid );
+} // namespace geode
+
+namespace geode
+{
+    namespace internal
+    {
+        /*!
+         * Writes the grid geometry in the Voxet file and each cell attribute
+         * in its own binary property file, as 4-byte big-endian floats.
+         * Values are narrowed to float: double attributes lose precision
+         * beyond about 7 significant digits. Attributes with several items,
+         * such as vectors, are written as one property per item, named
+         * after the attribute and the item index (e.g. "offset_0").
+         */
+        class VOOutput final : public RegularGridOutput< 3 >
+        {
+        public:
+            explicit VOOutput( std::string_view filename )
+                : RegularGridOutput< 3 >( filename )
+            {
+            }
+
+            static std::string_view extension()
+            {
+                static constexpr auto EXT = "vo";
+                return EXT;
+            }
+
+            std::vector< std::string > write(
+                const RegularGrid3D& grid ) const final;
+        };
+    } // namespace internal
+} // namespace geode
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <absl/types/span.h>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+
+namespace geode
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( EdgedCurve );
+    ALIAS_3D( EdgedCurve );
+} // namespace geode
+
+namespace geode
+{
+    namespace internal
+    {
+        /*!
+         * All the wells of a batch gathered in a single curve. The vertices
+         * of well w are [vertex_offsets[w], vertex_offsets[w + 1]) and its
+         * edges [edge_offsets[w], edge_offsets[w + 1]). Vertices and edges
+         * also store their well index in a WELL_ID_ATTRIBUTE_NAME attribute.
+         * Wells without a name are named after their file stem.
+         */
+        struct PackedWells
+        {
+            static constexpr auto WELL_ID_ATTRIBUTE_NAME = "well_id";
+
+            std::unique_ptr< EdgedCurve3D > curve;
+            std::vector< index_t > vertex_offsets;
+            std::vector< index_t > edge_offsets;
+            std::vector< std::string > names;
+        };
+
+        /*!
+         * Well files (wl, dev, txt and dat) found in the directory, sorted by
+         * name.
+         */
+        std::vector< std::string > opengeode_geosciencesio_mesh_api
+            well_files( std::string_view directory );
+
+        /*!
+         * Reads the well files concurrently, the reader being chosen from the
+         * file extension. Returns one curve per file, in the same order.
+         * A file that cannot be read aborts the batch with an exception
+         * giving its name.
+         */
+        std::vector< std::unique_ptr< EdgedCurve3D > >
+            opengeode_geosciencesio_mesh_api load_wells(
+                absl::Span< const std::string > filenames );
+
+        /*!
+         * Reads the well files concurrently into a single curve. Well vertex
+         * attributes of type double are merged by name, wells without a given
+         * attribute getting 0.
+         */
+        PackedWells opengeode_geosciencesio_mesh_api load_packed_wells(
+            absl::Span< const std::string > filenames );
+    } // namespace internal
+} // namespace geode
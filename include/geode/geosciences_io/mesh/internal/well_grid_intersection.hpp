@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include <absl/types/span.h>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+
+namespace geode
+{
+    FORWARD_DECLARATION_DIMENSION_CLASS( EdgedCurve );
+    FORWARD_DECLARATION_DIMENSION_CLASS( HybridSolid );
+    FORWARD_DECLARATION_DIMENSION_CLASS( RegularGrid );
+    ALIAS_3D( EdgedCurve );
+    ALIAS_3D( HybridSolid );
+    ALIAS_3D( RegularGrid );
+    namespace internal
+    {
+        class CornerPointGrid;
+    } // namespace internal
+} // namespace geode
+
+namespace geode
+{
+    namespace internal
+    {
+        /*!
+         * Part of a well trajectory lying in a grid cell. Depths are measured
+         * along the well, the length being that of the trajectory inside the
+         * cell.
+         */
+        struct WellCellIntersection
+        {
+            index_t cell;
+            double entry_depth;
+            double exit_depth;
+            double length;
+        };
+
+        /*!
+         * Name of the well vertex attribute giving the measured depths, as
+         * read from dev files. Wells without it are measured along their
+         * trajectory from their first vertex.
+         */
+        inline std::string_view well_measured_depth_attribute_name()
+        {
+            static constexpr auto NAME = "MD";
+            return NAME;
+        }
+
+        /*!
+         * Cells traversed by the well, ordered along the trajectory, computed
+         * by a 3D-DDA walk through the grid. The well is the polyline going
+         * through its vertices in order, as created by the well readers.
+         */
+        std::vector< WellCellIntersection > opengeode_geosciencesio_mesh_api
+            well_cell_intersections(
+                const RegularGrid3D& grid, const EdgedCurve3D& well );
+
+        /*!
+         * Active cells traversed by the well, ordered along the trajectory.
+         * Cells are located by walking from column to column along the
+         * pillars, then through the layers of the column, starting from the
+         * previous cell. Cell faces between pillars are ruled surfaces and
+         * cell tops and bottoms are bilinear in each column.
+         */
+        std::vector< WellCellIntersection > opengeode_geosciencesio_mesh_api
+            well_cell_intersections(
+                const CornerPointGrid& grid, const EdgedCurve3D& well );
+
+        /*!
+         * Intersections of each well with the grid, wells being processed
+         * in parallel.
+         */
+        std::vector< std::vector< WellCellIntersection > >
+            opengeode_geosciencesio_mesh_api wells_cell_intersections(
+                const RegularGrid3D& grid,
+                absl::Span< const std::unique_ptr< EdgedCurve3D > > wells );
+
+        std::vector< std::vector< WellCellIntersection > >
+            opengeode_geosciencesio_mesh_api wells_cell_intersections(
+                const CornerPointGrid& grid,
+                absl::Span< const std::unique_ptr< EdgedCurve3D > > wells );
+
+        /*!
+         * Intersections with a HybridSolid created from a corner-point grid,
+         * e.g. by the GRDECL reader. Cells are the polyhedra of the solid.
+         */
+        std::vector< std::vector< WellCellIntersection > >
+            opengeode_geosciencesio_mesh_api wells_cell_intersections(
+                const HybridSolid3D& solid,
+                absl::Span< const std::unique_ptr< EdgedCurve3D > > wells );
+    } // namespace internal
+} // namespace geode
@@ -25,12 +25,23 @@
 
 #include <geode/model/representation/io/section_input.hpp>
 
+#include <geode/geosciences_io/mesh/internal/gdal_configuration.hpp>
+
 #include <geode/geosciences_io/model/common.hpp>
 
 namespace geode
 {
     namespace internal
     {
+        struct SHPInputOptions
+        {
+            /*!
+             * GDAL settings applied during the read, on top of the library
+             * ones.
+             */
+            GDALConfiguration gdal;
+        };
+
         class SHPInput final : public SectionInput
         {
         public:
@@ -39,6 +50,12 @@ namespace geode
             {
             }
 
+            SHPInput(
+                std::string_view filename, const SHPInputOptions& options )
+                : SectionInput( filename ), options_( options )
+            {
+            }
+
             static std::vector< std::string > extensions()
             {
                 static const std::vector< std::string > extensions{ "shp",
@@ -56,6 +73,9 @@ namespace geode
             }
 
             Percentage is_loadable() const final;
+
+        private:
+            SHPInputOptions options_;
         };
     } // namespace internal
 } // namespace geode
\ No newline at end of file
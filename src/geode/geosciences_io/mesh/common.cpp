@@ -23,20 +23,23 @@
 
 #include <geode/geosciences_io/mesh/common.hpp>
 
-#include <gdal.h>
-
 #include <geode/io/image/common.hpp>
 
 #include <geode/geosciences_io/mesh/internal/dem_input.hpp>
+#include <geode/geosciences_io/mesh/internal/dem_tin_input.hpp>
+#include <geode/geosciences_io/mesh/internal/egrid_input.hpp>
 #include <geode/geosciences_io/mesh/internal/fem_output.hpp>
 #include <geode/geosciences_io/mesh/internal/geotiff_input.hpp>
+#include <geode/geosciences_io/mesh/internal/geotiff_output.hpp>
 #include <geode/geosciences_io/mesh/internal/grdecl_input.hpp>
+#include <geode/geosciences_io/mesh/internal/grdecl_output.hpp>
 #include <geode/geosciences_io/mesh/internal/pl_input.hpp>
 #include <geode/geosciences_io/mesh/internal/pl_output.hpp>
 #include <geode/geosciences_io/mesh/internal/polytiff_input.hpp>
 #include <geode/geosciences_io/mesh/internal/ts_input.hpp>
 #include <geode/geosciences_io/mesh/internal/ts_output.hpp>
 #include <geode/geosciences_io/mesh/internal/vo_input.hpp>
+#include <geode/geosciences_io/mesh/internal/vo_output.hpp>
 #include <geode/geosciences_io/mesh/internal/vs_input.hpp>
 #include <geode/geosciences_io/mesh/internal/vs_output.hpp>
 #include <geode/geosciences_io/mesh/internal/well_dat_input.hpp>
@@ -51,6 +54,9 @@ namespace
         geode::TriangulatedSurfaceInputFactory3D::register_creator<
             geode::internal::TSInput >(
             geode::internal::TSInput::extension().data() );
+        geode::TriangulatedSurfaceInputFactory3D::register_creator<
+            geode::internal::DEMTINInput >(
+            geode::internal::DEMTINInput::extension().data() );
     }
 
     void register_triangulated_surface_output()
@@ -115,6 +121,16 @@ namespace
         }
     }
 
+    void register_light_regular_grid_output()
+    {
+        for( const auto& tif_ext :
+            geode::internal::GEOTIFFOutput::extensions() )
+        {
+            geode::LightRegularGridOutputFactory2D::register_creator<
+                geode::internal::GEOTIFFOutput >( tif_ext );
+        }
+    }
+
     void register_regular_grid_input()
     {
         geode::RegularGridInputFactory3D::register_creator<
@@ -122,11 +138,31 @@ namespace
             geode::internal::VOInput::extension().data() );
     }
 
+    void register_regular_grid_output()
+    {
+        geode::RegularGridOutputFactory3D::register_creator<
+            geode::internal::RegularGridGRDECLOutput >(
+            geode::internal::RegularGridGRDECLOutput::extension().data() );
+        geode::RegularGridOutputFactory3D::register_creator<
+            geode::internal::VOOutput >(
+            geode::internal::VOOutput::extension().data() );
+    }
+
     void register_hybrid_solid_input()
     {
         geode::HybridSolidInputFactory3D::register_creator<
             geode::internal::GRDECLInput >(
             geode::internal::GRDECLInput::extension().data() );
+        geode::HybridSolidInputFactory3D::register_creator<
+            geode::internal::EGRIDInput >(
+            geode::internal::EGRIDInput::extension().data() );
+    }
+
+    void register_hybrid_solid_output()
+    {
+        geode::HybridSolidOutputFactory3D::register_creator<
+            geode::internal::GRDECLOutput >(
+            geode::internal::GRDECLOutput::extension().data() );
     }
 
     void register_point_set_input()
@@ -157,10 +193,12 @@ namespace geode
         register_edged_curve_input();
         register_edged_curve_output();
         register_light_regular_grid_input();
+        register_light_regular_grid_output();
         register_regular_grid_input();
+        register_regular_grid_output();
         register_hybrid_solid_input();
+        register_hybrid_solid_output();
         register_point_set_input();
         register_point_set_output();
-        GDALAllRegister();
     }
 } // namespace geode
@@ -0,0 +1,966 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/geosciences_io/mesh/internal/corner_point_grid.hpp>
+
+#include <async++.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <typeinfo>
+
+#include <absl/algorithm/container.h>
+#include <absl/container/fixed_array.h>
+
+#include <geode/basic/attribute_manager.hpp>
+#include <geode/basic/pimpl_impl.hpp>
+#include <geode/basic/variable_attribute.hpp>
+
+#include <geode/geometry/coordinate_system.hpp>
+#include <geode/geometry/nn_search.hpp>
+#include <geode/geometry/vector.hpp>
+
+#include <geode/mesh/builder/hybrid_solid_builder.hpp>
+#include <geode/mesh/core/hybrid_solid.hpp>
+#include <geode/mesh/core/regular_grid_solid.hpp>
+
+namespace
+{
+    enum struct DIRECTION : geode::local_index_t
+    {
+        i,
+        j,
+        k
+    };
+
+    // Offsets in i, j and k of the pillar and of the ZCORN layer of each
+    // hexahedron vertex, k increasing with depth.
+    static constexpr std::array< std::array< geode::index_t, 3 >, 8 >
+        CORNER_OFFSETS{ { { 0, 1, 1 }, { 1, 1, 1 }, { 1, 0, 1 }, { 0, 0, 1 },
+            { 0, 1, 0 }, { 1, 1, 0 }, { 1, 0, 0 }, { 0, 0, 0 } } };
+
+    // Hexahedron vertices of the face pointing towards increasing i, j or k
+    // (upper) and of the opposite face (lower), ordered so that the v-th
+    // upper vertex of a cell matches the v-th lower vertex of the next cell.
+    static constexpr std::array< std::array< geode::local_index_t, 4 >, 3 >
+        UPPER_FACE_VERTICES{ { { 1, 2, 6, 5 }, { 0, 1, 5, 4 },
+            { 0, 1, 2, 3 } } };
+    static constexpr std::array< std::array< geode::local_index_t, 4 >, 3 >
+        LOWER_FACE_VERTICES{ { { 0, 3, 7, 4 }, { 3, 2, 6, 7 },
+            { 4, 5, 6, 7 } } };
+
+    struct DirectionFacets
+    {
+        std::array< geode::local_index_t, 3 > upper;
+        std::array< geode::local_index_t, 3 > lower;
+    };
+
+    struct CornerIndices
+    {
+        geode::index_t pillar;
+        geode::index_t depth;
+    };
+
+    // Pillar and ZCORN value of the v-th corner of the cell (i,j,k)
+    CornerIndices corner_indices(
+        const std::array< geode::index_t, 3 >& nb_cells,
+        const std::array< geode::index_t, 3 >& grid_coordinates,
+        geode::local_index_t v )
+    {
+        const auto [i, j, k] = grid_coordinates;
+        const auto nx = nb_cells[0];
+        const auto& offsets = CORNER_OFFSETS[v];
+        return { i + offsets[0] + ( nx + 1 ) * ( j + offsets[1] ),
+            2 * i + offsets[0] + 2 * nx * ( 2 * j + offsets[1] )
+                + 4 * nx * nb_cells[1] * ( 2 * k + offsets[2] ) };
+    }
+
+    std::array< geode::index_t, 3 > grid_nb_cells(
+        const geode::internal::CornerPointGrid& grid )
+    {
+        return { grid.nb_cells_in_direction( 0 ),
+            grid.nb_cells_in_direction( 1 ), grid.nb_cells_in_direction( 2 ) };
+    }
+
+    bool is_face_in_facet(
+        const std::array< geode::local_index_t, 4 >& face_vertices,
+        const std::array< bool, 8 >& in_facet )
+    {
+        return absl::c_all_of( face_vertices, [&in_facet]( const auto v ) {
+            return in_facet[v];
+        } );
+    }
+
+    geode::Point3D interpolate_on_pillar(
+        const double depth, absl::Span< const double > pillar )
+    {
+        const geode::Point3D top{ { pillar[0], pillar[1], pillar[2] } };
+        const geode::Point3D bottom{ { pillar[3], pillar[4], pillar[5] } };
+        const auto lambda =
+            ( depth - top.value( 2 ) ) / ( bottom.value( 2 ) - top.value( 2 ) );
+        return bottom * lambda + top * ( 1 - lambda );
+    }
+
+    // Pillars stored as separate coordinate arrays, each pillar being
+    // given by its top point and its slope relative to depth.
+    class PillarArrays
+    {
+    public:
+        explicit PillarArrays( const geode::internal::CornerPointGrid& grid )
+            : top_x_( grid.nb_pillars() ),
+              top_y_( grid.nb_pillars() ),
+              top_z_( grid.nb_pillars() ),
+              slope_x_( grid.nb_pillars() ),
+              slope_y_( grid.nb_pillars() )
+        {
+            const auto coordinates = grid.pillar_coordinates();
+            for( const auto pillar : geode::Range{ grid.nb_pillars() } )
+            {
+                const auto* values = &coordinates[6 * pillar];
+                const auto height = values[5] - values[2];
+                top_x_[pillar] = values[0];
+                top_y_[pillar] = values[1];
+                top_z_[pillar] = values[2];
+                slope_x_[pillar] = ( values[3] - values[0] ) / height;
+                slope_y_[pillar] = ( values[4] - values[1] ) / height;
+            }
+        }
+
+        geode::Point3D point( geode::index_t pillar, double depth ) const
+        {
+            const auto offset = depth - top_z_[pillar];
+            return geode::Point3D{ { top_x_[pillar] + offset * slope_x_[pillar],
+                top_y_[pillar] + offset * slope_y_[pillar], depth } };
+        }
+
+    private:
+        absl::FixedArray< double > top_x_;
+        absl::FixedArray< double > top_y_;
+        absl::FixedArray< double > top_z_;
+        absl::FixedArray< double > slope_x_;
+        absl::FixedArray< double > slope_y_;
+    };
+
+    class HybridSolidCreator
+    {
+    public:
+        HybridSolidCreator( const geode::internal::CornerPointGrid& grid,
+            geode::HybridSolid3D& solid,
+            bool skip_inactive_cells )
+            : grid_( grid ),
+              solid_( solid ),
+              builder_{ geode::HybridSolidBuilder3D::create( solid ) },
+              skip_inactive_cells_{ skip_inactive_cells }
+        {
+        }
+
+        void create()
+        {
+            set_active_cells();
+            create_cells();
+            create_grid_coordinates_attribute();
+            if( !skip_inactive_cells_ && grid_.defines_active_cells() )
+            {
+                create_active_cells_attribute();
+            }
+            create_property_attributes();
+        }
+
+    private:
+        void set_active_cells()
+        {
+            nb_polyhedra_ = grid_.nb_cells();
+            if( !skip_inactive_cells_ || !grid_.defines_active_cells() )
+            {
+                return;
+            }
+            active_cells_.reserve( grid_.nb_active_cells() );
+            cell_polyhedra_.resize( grid_.nb_cells(), geode::NO_ID );
+            nb_polyhedra_ = 0;
+            for( const auto cell : geode::Range{ grid_.nb_cells() } )
+            {
+                if( grid_.is_cell_active( cell ) )
+                {
+                    cell_polyhedra_[cell] = nb_polyhedra_++;
+                    active_cells_.push_back( cell );
+                }
+            }
+        }
+
+        geode::index_t polyhedron_cell( geode::index_t polyhedron ) const
+        {
+            if( active_cells_.empty() )
+            {
+                return polyhedron;
+            }
+            return active_cells_[polyhedron];
+        }
+
+        geode::index_t cell_polyhedron( geode::index_t cell ) const
+        {
+            if( cell_polyhedra_.empty() )
+            {
+                return cell;
+            }
+            return cell_polyhedra_[cell];
+        }
+
+        // Polyhedra are sorted by cell, so each k-layer of cells is a
+        // contiguous range of polyhedra.
+        geode::index_t layer_first_polyhedron( geode::index_t k ) const
+        {
+            const auto first_cell = k * grid_.nb_cells_in_direction( 0 )
+                                    * grid_.nb_cells_in_direction( 1 );
+            if( active_cells_.empty() )
+            {
+                return first_cell;
+            }
+            return static_cast< geode::index_t >(
+                absl::c_lower_bound( active_cells_, first_cell )
+                - active_cells_.begin() );
+        }
+
+        void interpolate_cell_corners( const PillarArrays& pillars,
+            geode::index_t polyhedron,
+            absl::Span< geode::Point3D > points ) const
+        {
+            const auto nb_cells = grid_nb_cells( grid_ );
+            const auto depths = grid_.corner_depths();
+            const auto grid_coordinates =
+                grid_.cell_grid_coordinates( polyhedron_cell( polyhedron ) );
+            for( const auto v : geode::LRange{ 8 } )
+            {
+                const auto corner =
+                    corner_indices( nb_cells, grid_coordinates, v );
+                points[8 * polyhedron + v] =
+                    pillars.point( corner.pillar, depths[corner.depth] );
+            }
+        }
+
+        geode::NNSearch3D::ColocatedInfo create_points()
+        {
+            const PillarArrays pillars{ grid_ };
+            std::vector< geode::Point3D > points( 8 * nb_polyhedra_ );
+            async::parallel_for( async::irange( geode::index_t{ 0 },
+                                     grid_.nb_cells_in_direction( 2 ) ),
+                [this, &pillars, &points]( geode::index_t k ) {
+                    for( const auto polyhedron :
+                        geode::Range{ layer_first_polyhedron( k ),
+                            layer_first_polyhedron( k + 1 ) } )
+                    {
+                        interpolate_cell_corners(
+                            pillars, polyhedron, absl::MakeSpan( points ) );
+                    }
+                } );
+            const auto collocated_mapping =
+                geode::NNSearch3D{ std::move( points ) }
+                    .colocated_index_mapping( geode::GLOBAL_EPSILON );
+            const auto& unique_points = collocated_mapping.unique_points;
+            builder_->create_vertices(
+                static_cast< geode::index_t >( unique_points.size() ) );
+            for( const auto vertex : geode::Indices{ unique_points } )
+            {
+                builder_->set_point( vertex, unique_points[vertex] );
+            }
+            return collocated_mapping;
+        }
+
+        void create_cells()
+        {
+            const auto collocated_mapping = create_points();
+            const auto& cell_vertices = collocated_mapping.colocated_mapping;
+            std::array< geode::index_t, 8 > hexahedron;
+            for( const auto polyhedron : geode::Range{ nb_polyhedra_ } )
+            {
+                absl::c_copy(
+                    absl::MakeConstSpan( cell_vertices )
+                        .subspan( 8 * polyhedron, 8 ),
+                    hexahedron.begin() );
+                builder_->create_hexahedron( hexahedron );
+            }
+            compute_polyhedron_adjacencies( cell_vertices );
+        }
+
+        void compute_polyhedron_adjacencies(
+            absl::Span< const geode::index_t > cell_vertices )
+        {
+            if( solid_.nb_polyhedra() == 0 )
+            {
+                return;
+            }
+            const auto facets = direction_facets();
+            std::vector< bool > is_faulted( solid_.nb_polyhedra(), false );
+            const auto nb_cells = grid_nb_cells( grid_ );
+            const std::array< geode::index_t, 3 > next_cell_offsets{ 1,
+                nb_cells[0], nb_cells[0] * nb_cells[1] };
+            for( const auto polyhedron : geode::Range{ solid_.nb_polyhedra() } )
+            {
+                const auto cell = polyhedron_cell( polyhedron );
+                const auto grid_coordinates =
+                    grid_.cell_grid_coordinates( cell );
+                for( const auto d : geode::LRange{ 3 } )
+                {
+                    if( grid_coordinates[d] + 1 == nb_cells[d] )
+                    {
+                        continue;
+                    }
+                    const auto next_polyhedron =
+                        cell_polyhedron( cell + next_cell_offsets[d] );
+                    if( next_polyhedron == geode::NO_ID )
+                    {
+                        continue;
+                    }
+                    connect_cells( polyhedron, next_polyhedron,
+                        static_cast< DIRECTION >( d ), facets, cell_vertices,
+                        is_faulted );
+                }
+            }
+            std::vector< geode::index_t > faulted_polyhedra;
+            for( const auto polyhedron : geode::Indices{ is_faulted } )
+            {
+                if( is_faulted[polyhedron] )
+                {
+                    faulted_polyhedra.push_back( polyhedron );
+                }
+            }
+            if( !faulted_polyhedra.empty() )
+            {
+                builder_->compute_polyhedron_adjacencies( faulted_polyhedra );
+            }
+        }
+
+        void connect_cells( geode::index_t polyhedron,
+            geode::index_t next_polyhedron,
+            DIRECTION direction,
+            const DirectionFacets& facets,
+            absl::Span< const geode::index_t > cell_vertices,
+            std::vector< bool >& is_faulted )
+        {
+            const auto d = static_cast< geode::local_index_t >( direction );
+            for( const auto v : geode::LRange{ 4 } )
+            {
+                if( cell_vertices[8 * polyhedron + UPPER_FACE_VERTICES[d][v]]
+                    != cell_vertices[8 * next_polyhedron
+                                     + LOWER_FACE_VERTICES[d][v]] )
+                {
+                    is_faulted[polyhedron] = true;
+                    is_faulted[next_polyhedron] = true;
+                    return;
+                }
+            }
+            builder_->set_polyhedron_adjacent(
+                { polyhedron, facets.upper[d] }, next_polyhedron );
+            builder_->set_polyhedron_adjacent(
+                { next_polyhedron, facets.lower[d] }, polyhedron );
+        }
+
+        DirectionFacets direction_facets() const
+        {
+            DirectionFacets facets;
+            for( const auto facet :
+                geode::LRange{ solid_.nb_polyhedron_facets( 0 ) } )
+            {
+                const geode::PolyhedronFacet polyhedron_facet{ 0, facet };
+                std::array< bool, 8 > in_facet;
+                in_facet.fill( false );
+                for( const auto v : geode::LRange{
+                         solid_.nb_polyhedron_facet_vertices(
+                             polyhedron_facet ) } )
+                {
+                    in_facet[solid_
+                            .polyhedron_facet_vertex_id(
+                                { polyhedron_facet, v } )
+                            .vertex_id] = true;
+                }
+                for( const auto d : geode::LRange{ 3 } )
+                {
+                    if( is_face_in_facet( UPPER_FACE_VERTICES[d], in_facet ) )
+                    {
+                        facets.upper[d] = facet;
+                    }
+                    else if( is_face_in_facet(
+                                 LOWER_FACE_VERTICES[d], in_facet ) )
+                    {
+                        facets.lower[d] = facet;
+                    }
+                }
+            }
+            return facets;
+        }
+
+        void create_grid_coordinates_attribute()
+        {
+            auto attribute =
+                solid_.polyhedron_attribute_manager()
+                    .find_or_create_attribute< geode::VariableAttribute,
+                        std::array< geode::index_t, 3 > >(
+                        geode::internal::CornerPointGrid::
+                            grid_coordinates_attribute_name(),
+                        { geode::NO_ID, geode::NO_ID, geode::NO_ID } );
+            for( const auto polyhedron : geode::Range{ nb_polyhedra_ } )
+            {
+                attribute->set_value( polyhedron,
+                    grid_.cell_grid_coordinates(
+                        polyhedron_cell( polyhedron ) ) );
+            }
+        }
+
+        void create_active_cells_attribute()
+        {
+            auto attribute =
+                solid_.polyhedron_attribute_manager()
+                    .find_or_create_attribute< geode::VariableAttribute,
+                        double >( "ACTNUM", 0 );
+            for( const auto polyhedron : geode::Range{ nb_polyhedra_ } )
+            {
+                attribute->set_value(
+                    polyhedron, grid_.is_cell_active( polyhedron ) ? 1 : 0 );
+            }
+        }
+
+        void create_property_attributes()
+        {
+            auto& attribute_manager = solid_.polyhedron_attribute_manager();
+            for( const auto name : grid_.cell_property_names() )
+            {
+                const auto values = grid_.cell_property( name );
+                auto attribute = attribute_manager.find_or_create_attribute<
+                    geode::VariableAttribute, double >( name, 0 );
+                for( const auto polyhedron : geode::Range{ nb_polyhedra_ } )
+                {
+                    attribute->set_value(
+                        polyhedron, values[polyhedron_cell( polyhedron )] );
+                }
+            }
+        }
+
+    private:
+        const geode::internal::CornerPointGrid& grid_;
+        geode::HybridSolid3D& solid_;
+        std::unique_ptr< geode::HybridSolidBuilder3D > builder_;
+        bool skip_inactive_cells_;
+        geode::index_t nb_polyhedra_{ 0 };
+        std::vector< geode::index_t > active_cells_;
+        std::vector< geode::index_t > cell_polyhedra_;
+    };
+
+    void set_pillar( absl::Span< double > coordinates,
+        geode::index_t pillar,
+        const geode::Point3D& top,
+        const geode::Point3D& bottom )
+    {
+        for( const auto d : geode::LRange{ 3 } )
+        {
+            coordinates[6 * pillar + d] = top.value( d );
+            coordinates[6 * pillar + 3 + d] = bottom.value( d );
+        }
+    }
+
+    // The pillars go through the shallowest and the deepest corners found
+    // on them. Corners of missing cells are put on top of their pillar.
+    void set_hybrid_solid_geometry( geode::internal::CornerPointGrid& grid,
+        const geode::HybridSolid3D& solid,
+        absl::Span< const geode::index_t > polyhedron_cells )
+    {
+        const auto nb_cells = grid_nb_cells( grid );
+        const auto depths = grid.modifiable_corner_depths();
+        std::vector< std::optional< geode::Point3D > > tops(
+            grid.nb_pillars() );
+        std::vector< std::optional< geode::Point3D > > bottoms(
+            grid.nb_pillars() );
+        std::vector< bool > is_defined( grid.nb_cells(), false );
+        for( const auto polyhedron : geode::Range{ solid.nb_polyhedra() } )
+        {
+            const auto cell = polyhedron_cells[polyhedron];
+            is_defined[cell] = true;
+            const auto grid_coordinates = grid.cell_grid_coordinates( cell );
+            for( const auto v : geode::LRange{ 8 } )
+            {
+                const auto& point =
+                    solid.point( solid.polyhedron_vertex( { polyhedron, v } ) );
+                const auto corner =
+                    corner_indices( nb_cells, grid_coordinates, v );
+                depths[corner.depth] = point.value( 2 );
+                auto& top = tops[corner.pillar];
+                if( !top || point.value( 2 ) < top->value( 2 ) )
+                {
+                    top = point;
+                }
+                auto& bottom = bottoms[corner.pillar];
+                if( !bottom || point.value( 2 ) > bottom->value( 2 ) )
+                {
+                    bottom = point;
+                }
+            }
+        }
+        const auto coordinates = grid.modifiable_pillar_coordinates();
+        for( const auto pillar : geode::Range{ grid.nb_pillars() } )
+        {
+            const auto top = tops[pillar].value_or( geode::Point3D{} );
+            auto bottom = bottoms[pillar].value_or( top );
+            if( bottom.value( 2 ) == top.value( 2 ) )
+            {
+                bottom.set_value( 2, top.value( 2 ) + 1 );
+            }
+            set_pillar( coordinates, pillar, top, bottom );
+        }
+        for( const auto cell : geode::Range{ grid.nb_cells() } )
+        {
+            if( is_defined[cell] )
+            {
+                continue;
+            }
+            const auto grid_coordinates = grid.cell_grid_coordinates( cell );
+            for( const auto v : geode::LRange{ 8 } )
+            {
+                const auto corner =
+                    corner_indices( nb_cells, grid_coordinates, v );
+                depths[corner.depth] = coordinates[6 * corner.pillar + 2];
+            }
+        }
+    }
+
+    void set_hybrid_solid_active_cells( geode::internal::CornerPointGrid& grid,
+        const geode::HybridSolid3D& solid,
+        absl::Span< const geode::index_t > polyhedron_cells )
+    {
+        const auto& attribute_manager = solid.polyhedron_attribute_manager();
+        const auto has_actnum = attribute_manager.attribute_exists( "ACTNUM" );
+        if( !has_actnum && solid.nb_polyhedra() == grid.nb_cells() )
+        {
+            return;
+        }
+        std::vector< bool > is_active( grid.nb_cells(), false );
+        for( const auto polyhedron : geode::Range{ solid.nb_polyhedra() } )
+        {
+            is_active[polyhedron_cells[polyhedron]] = true;
+        }
+        if( has_actnum )
+        {
+            const auto actnum =
+                attribute_manager.find_attribute< double >( "ACTNUM" );
+            for( const auto polyhedron : geode::Range{ solid.nb_polyhedra() } )
+            {
+                is_active[polyhedron_cells[polyhedron]] =
+                    actnum->value( polyhedron ) != 0;
+            }
+        }
+        grid.set_active_cells( std::move( is_active ) );
+    }
+
+    template < typename ElementCell >
+    void add_cell_properties( geode::internal::CornerPointGrid& grid,
+        const geode::AttributeManager& attribute_manager,
+        ElementCell&& element_cell )
+    {
+        for( const auto& name : attribute_manager.attribute_names() )
+        {
+            const auto attribute =
+                attribute_manager.find_generic_attribute( name );
+            if( !attribute || name == "ACTNUM"
+                || attribute->type() != typeid( double ).name() )
+            {
+                continue;
+            }
+            const auto values_attribute =
+                attribute_manager.find_attribute< double >( name );
+            std::vector< double > values( grid.nb_cells(), 0 );
+            for( const auto element :
+                geode::Range{ attribute_manager.nb_elements() } )
+            {
+                values[element_cell( element )] =
+                    values_attribute->value( element );
+            }
+            grid.add_cell_property( name, std::move( values ) );
+        }
+    }
+} // namespace
+
+namespace geode
+{
+    namespace internal
+    {
+        class CornerPointGrid::Impl
+        {
+            struct CellProperty
+            {
+                std::string name;
+                std::vector< double > values;
+            };
+
+        public:
+            Impl( index_t nx, index_t ny, index_t nz )
+                : nb_cells_{ nx, ny, nz },
+                  coordinates_( 6 * ( nx + 1 ) * ( ny + 1 ) ),
+                  depths_( 8 * nx * ny * nz )
+            {
+            }
+
+            index_t nb_cells_in_direction( local_index_t direction ) const
+            {
+                return nb_cells_[direction];
+            }
+
+            index_t nb_cells() const
+            {
+                return nb_cells_[0] * nb_cells_[1] * nb_cells_[2];
+            }
+
+            index_t nb_pillars() const
+            {
+                return ( nb_cells_[0] + 1 ) * ( nb_cells_[1] + 1 );
+            }
+
+            index_t cell_index(
+                const std::array< index_t, 3 >& grid_coordinates ) const
+            {
+                return grid_coordinates[0]
+                       + nb_cells_[0]
+                             * ( grid_coordinates[1]
+                                 + nb_cells_[1] * grid_coordinates[2] );
+            }
+
+            std::array< index_t, 3 > cell_grid_coordinates( index_t cell ) const
+            {
+                return { cell % nb_cells_[0],
+                    ( cell / nb_cells_[0] ) % nb_cells_[1],
+                    cell / ( nb_cells_[0] * nb_cells_[1] ) };
+            }
+
+            absl::Span< const double > pillar_coordinates() const
+            {
+                return coordinates_;
+            }
+
+            absl::Span< double > modifiable_pillar_coordinates()
+            {
+                return absl::MakeSpan( coordinates_ );
+            }
+
+            absl::Span< const double > corner_depths() const
+            {
+                return depths_;
+            }
+
+            absl::Span< double > modifiable_corner_depths()
+            {
+                return absl::MakeSpan( depths_ );
+            }
+
+            bool defines_active_cells() const
+            {
+                return !is_active_.empty();
+            }
+
+            bool is_cell_active( index_t cell ) const
+            {
+                return is_active_.empty() || is_active_[cell];
+            }
+
+            index_t nb_active_cells() const
+            {
+                return nb_active_cells_;
+            }
+
+            void set_active_cells( std::vector< bool > is_active )
+            {
+                OpenGeodeGeosciencesIOMeshException::check_exception(
+                    is_active.size() == nb_cells(), nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[CornerPointGrid::set_active_cells] Wrong number of "
+                    "cells" );
+                is_active_ = std::move( is_active );
+                nb_active_cells_ = static_cast< index_t >(
+                    absl::c_count( is_active_, true ) );
+            }
+
+            void add_cell_property(
+                std::string_view name, std::vector< double > values )
+            {
+                OpenGeodeGeosciencesIOMeshException::check_exception(
+                    values.size() == nb_cells(), nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[CornerPointGrid::add_cell_property] Wrong number of "
+                    "values for ",
+                    name );
+                properties_.push_back(
+                    { to_string( name ), std::move( values ) } );
+            }
+
+            std::vector< std::string_view > cell_property_names() const
+            {
+                std::vector< std::string_view > names;
+                names.reserve( properties_.size() );
+                for( const auto& property : properties_ )
+                {
+                    names.emplace_back( property.name );
+                }
+                return names;
+            }
+
+            absl::Span< const double > cell_property(
+                std::string_view name ) const
+            {
+                for( const auto& property : properties_ )
+                {
+                    if( property.name == name )
+                    {
+                        return property.values;
+                    }
+                }
+                throw OpenGeodeGeosciencesIOMeshException{ nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[CornerPointGrid::cell_property] Unknown property ",
+                    name };
+            }
+
+            std::array< Point3D, 8 > cell_corners( index_t cell ) const
+            {
+                const auto grid_coordinates = cell_grid_coordinates( cell );
+                absl::Span< const double > coordinates{ coordinates_ };
+                std::array< Point3D, 8 > corners;
+                for( const auto v : LRange{ 8 } )
+                {
+                    const auto corner =
+                        corner_indices( nb_cells_, grid_coordinates, v );
+                    corners[v] = interpolate_on_pillar( depths_[corner.depth],
+                        coordinates.subspan( 6 * corner.pillar, 6 ) );
+                }
+                return corners;
+            }
+
+        private:
+            std::array< index_t, 3 > nb_cells_;
+            absl::FixedArray< double > coordinates_;
+            absl::FixedArray< double > depths_;
+            std::vector< bool > is_active_;
+            index_t nb_active_cells_{ 0 };
+            std::vector< CellProperty > properties_;
+        };
+
+        CornerPointGrid::CornerPointGrid( index_t nx, index_t ny, index_t nz )
+            : impl_( nx, ny, nz )
+        {
+        }
+
+        CornerPointGrid::CornerPointGrid( CornerPointGrid&& ) noexcept =
+            default;
+
+        CornerPointGrid& CornerPointGrid::operator=(
+            CornerPointGrid&& ) noexcept = default;
+
+        CornerPointGrid::~CornerPointGrid() = default;
+
+        index_t CornerPointGrid::nb_cells_in_direction(
+            local_index_t direction ) const
+        {
+            return impl_->nb_cells_in_direction( direction );
+        }
+
+        index_t CornerPointGrid::nb_cells() const
+        {
+            return impl_->nb_cells();
+        }
+
+        index_t CornerPointGrid::nb_pillars() const
+        {
+            return impl_->nb_pillars();
+        }
+
+        index_t CornerPointGrid::cell_index(
+            const std::array< index_t, 3 >& grid_coordinates ) const
+        {
+            return impl_->cell_index( grid_coordinates );
+        }
+
+        std::array< index_t, 3 > CornerPointGrid::cell_grid_coordinates(
+            index_t cell ) const
+        {
+            return impl_->cell_grid_coordinates( cell );
+        }
+
+        absl::Span< const double > CornerPointGrid::pillar_coordinates() const
+        {
+            return impl_->pillar_coordinates();
+        }
+
+        absl::Span< double > CornerPointGrid::modifiable_pillar_coordinates()
+        {
+            return impl_->modifiable_pillar_coordinates();
+        }
+
+        absl::Span< const double > CornerPointGrid::corner_depths() const
+        {
+            return impl_->corner_depths();
+        }
+
+        absl::Span< double > CornerPointGrid::modifiable_corner_depths()
+        {
+            return impl_->modifiable_corner_depths();
+        }
+
+        bool CornerPointGrid::defines_active_cells() const
+        {
+            return impl_->defines_active_cells();
+        }
+
+        bool CornerPointGrid::is_cell_active( index_t cell ) const
+        {
+            return impl_->is_cell_active( cell );
+        }
+
+        index_t CornerPointGrid::nb_active_cells() const
+        {
+            if( !impl_->defines_active_cells() )
+            {
+                return impl_->nb_cells();
+            }
+            return impl_->nb_active_cells();
+        }
+
+        void CornerPointGrid::set_active_cells( std::vector< bool > is_active )
+        {
+            impl_->set_active_cells( std::move( is_active ) );
+        }
+
+        void CornerPointGrid::add_cell_property(
+            std::string_view name, std::vector< double > values )
+        {
+            impl_->add_cell_property( name, std::move( values ) );
+        }
+
+        std::vector< std::string_view >
+            CornerPointGrid::cell_property_names() const
+        {
+            return impl_->cell_property_names();
+        }
+
+        absl::Span< const double > CornerPointGrid::cell_property(
+            std::string_view name ) const
+        {
+            return impl_->cell_property( name );
+        }
+
+        std::array< Point3D, 8 > CornerPointGrid::cell_corners(
+            index_t cell ) const
+        {
+            return impl_->cell_corners( cell );
+        }
+
+        std::unique_ptr< HybridSolid3D > CornerPointGrid::hybrid_solid(
+            const MeshImpl& impl, bool skip_inactive_cells ) const
+        {
+            auto solid = HybridSolid3D::create( impl );
+            HybridSolidCreator{ *this, *solid, skip_inactive_cells }.create();
+            return solid;
+        }
+
+        CornerPointGrid corner_point_grid_from_hybrid_solid(
+            const HybridSolid3D& solid )
+        {
+            const auto& attribute_manager =
+                solid.polyhedron_attribute_manager();
+            const auto attribute_name =
+                CornerPointGrid::grid_coordinates_attribute_name();
+            OpenGeodeGeosciencesIOMeshException::check_exception(
+                attribute_manager.attribute_exists( attribute_name ), nullptr,
+                OpenGeodeException::TYPE::data,
+                "[corner_point_grid_from_hybrid_solid] Missing ",
+                attribute_name, " polyhedron attribute" );
+            const auto grid_coordinates =
+                attribute_manager.find_attribute< std::array< index_t, 3 > >(
+                    attribute_name );
+            std::array< index_t, 3 > nb_cells{ 0, 0, 0 };
+            for( const auto polyhedron : Range{ solid.nb_polyhedra() } )
+            {
+                const auto& coordinates = grid_coordinates->value( polyhedron );
+                for( const auto d : LRange{ 3 } )
+                {
+                    nb_cells[d] = std::max( nb_cells[d], coordinates[d] + 1 );
+                }
+            }
+            CornerPointGrid grid{ nb_cells[0], nb_cells[1], nb_cells[2] };
+            std::vector< index_t > polyhedron_cells( solid.nb_polyhedra() );
+            for( const auto polyhedron : Range{ solid.nb_polyhedra() } )
+            {
+                polyhedron_cells[polyhedron] =
+                    grid.cell_index( grid_coordinates->value( polyhedron ) );
+            }
+            set_hybrid_solid_geometry( grid, solid, polyhedron_cells );
+            set_hybrid_solid_active_cells( grid, solid, polyhedron_cells );
+            add_cell_properties( grid, attribute_manager,
+                [&polyhedron_cells]( index_t polyhedron ) {
+                    return polyhedron_cells[polyhedron];
+                } );
+            return grid;
+        }
+
+        CornerPointGrid corner_point_grid_from_regular_grid(
+            const RegularGrid3D& regular_grid )
+        {
+            OpenGeodeGeosciencesIOMeshException::check_exception(
+                regular_grid.grid_coordinate_system().direction( 2 ).value( 2 )
+                    != 0,
+                nullptr, OpenGeodeException::TYPE::data,
+                "[corner_point_grid_from_regular_grid] The third grid "
+                "direction should not be horizontal: pillars would have no "
+                "height" );
+            CornerPointGrid grid{ regular_grid.nb_cells_in_direction( 0 ),
+                regular_grid.nb_cells_in_direction( 1 ),
+                regular_grid.nb_cells_in_direction( 2 ) };
+            const auto nb_cells = grid_nb_cells( grid );
+            const auto coordinates = grid.modifiable_pillar_coordinates();
+            for( const auto j : Range{ nb_cells[1] + 1 } )
+            {
+                for( const auto i : Range{ nb_cells[0] + 1 } )
+                {
+                    set_pillar( coordinates, i + ( nb_cells[0] + 1 ) * j,
+                        regular_grid.grid_point( { i, j, 0 } ),
+                        regular_grid.grid_point( { i, j, nb_cells[2] } ) );
+                }
+            }
+            const auto depths = grid.modifiable_corner_depths();
+            for( const auto cell : Range{ grid.nb_cells() } )
+            {
+                const auto [i, j, k] = grid.cell_grid_coordinates( cell );
+                for( const auto v : LRange{ 8 } )
+                {
+                    const auto& offsets = CORNER_OFFSETS[v];
+                    const auto corner =
+                        corner_indices( nb_cells, { i, j, k }, v );
+                    depths[corner.depth] =
+                        regular_grid
+                            .grid_point( { i + offsets[0], j + offsets[1],
+                                k + offsets[2] } )
+                            .value( 2 );
+                }
+            }
+            add_cell_properties( grid, regular_grid.cell_attribute_manager(),
+                []( index_t cell ) {
+                    return cell;
+                } );
+            return grid;
+        }
+    } // namespace internal
+} // namespace geode
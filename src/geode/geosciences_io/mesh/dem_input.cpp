@@ -23,6 +23,16 @@
 
 #include <geode/geosciences_io/mesh/internal/dem_input.hpp>
 
+#include <async++.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#include <absl/algorithm/container.h>
+
 #include <gdal.h>
 #include <gdal_priv.h>
 #include <gdal_utils.h>
@@ -36,8 +46,15 @@
 
 #include <geode/io/image/detail/gdal_file.hpp>
 
+#include <geode/geosciences_io/mesh/internal/raster_level.hpp>
+
 namespace
 {
+    // Maximum number of pixels read at once
+    static constexpr geode::index_t STRIP_TARGET_SIZE{ 16 * 1024 * 1024 };
+
+    using Quad = std::array< geode::index_t, 4 >;
+
     class DEMInputImpl : public geode::detail::GDALFile
     {
     public:
@@ -48,71 +65,120 @@ namespace
         {
         }
 
-        void read_file()
+        // The raster is processed by strips of block rows: only one strip of
+        // elevations and vertex ids is kept, plus the vertex ids of the last
+        // row of the previous strip to link both strips with quads.
+        void read_file( const geode::internal::RasterLevelOptions& level )
         {
-            read_metadata();
-            const auto vertices = read_vertices();
-            create_polygons( vertices );
+            read_metadata( level );
+            const auto strip_height = this->strip_height();
+            std::vector< geode::index_t > previous_row;
+            for( geode::index_t first_row = 0; first_row < height_;
+                 first_row += strip_height )
+            {
+                const auto nb_rows =
+                    std::min( strip_height, height_ - first_row );
+                const auto vertices = read_vertices( first_row, nb_rows );
+                create_polygons( previous_row, vertices, nb_rows );
+                previous_row.assign( vertices.end() - width_, vertices.end() );
+            }
         }
 
     private:
-        void create_polygons( absl::Span< const geode::index_t > vertices )
+        // Strips hold at most STRIP_TARGET_SIZE pixels, in whole rows of
+        // GDAL blocks when a block row fits. Block rows are converted to
+        // level rows when reading an overview or another resolution.
+        geode::index_t strip_height() const
         {
-            for( const auto i : geode::Range{ height_ - 1 } )
-            {
-                const auto i_offset = i * width_;
-                for( const auto j : geode::Range{ width_ - 1 } )
-                {
-                    const auto j_offset = j + width_;
-                    std::array polygon{ i_offset + j, i_offset + j + 1,
-                        i_offset + j_offset, i_offset + j_offset + 1 };
-                    bool found{ true };
-                    for( auto& vertex : polygon )
+            int block_width;
+            int block_height;
+            band_->GetBlockSize( &block_width, &block_height );
+            const auto block_rows = std::max( geode::index_t{ 1 },
+                static_cast< geode::index_t >( std::ceil(
+                    static_cast< double >( std::max( block_height, 1 ) )
+                    * height_ / raster_height_ ) ) );
+            const auto max_rows = std::max( geode::index_t{ 1 },
+                STRIP_TARGET_SIZE / std::max( width_, geode::index_t{ 1 } ) );
+            const auto strip_rows =
+                block_rows <= max_rows ? max_rows - max_rows % block_rows
+                                       : max_rows;
+            return std::min( strip_rows, height_ );
+        }
+
+        void create_polygons( absl::Span< const geode::index_t > previous_row,
+            absl::Span< const geode::index_t > vertices,
+            geode::index_t nb_rows )
+        {
+            std::vector< std::vector< Quad > > row_quads( nb_rows );
+            async::parallel_for( async::irange( geode::index_t{ 0 }, nb_rows ),
+                [&]( geode::index_t row ) {
+                    const auto top =
+                        row == 0 ? previous_row
+                                 : vertices.subspan(
+                                       ( row - 1 ) * width_, width_ );
+                    if( top.empty() )
                     {
-                        const auto vertex_id = vertices[vertex];
-                        if( vertex_id == geode::NO_ID )
-                        {
-                            found = false;
-                            break;
-                        }
-                        vertex = vertex_id;
+                        return;
                     }
-                    if( !found )
+                    const auto bottom =
+                        vertices.subspan( row * width_, width_ );
+                    auto& quads = row_quads[row];
+                    for( const auto j : geode::Range{ width_ - 1 } )
                     {
-                        continue;
+                        const Quad quad{ top[j], top[j + 1], bottom[j + 1],
+                            bottom[j] };
+                        if( absl::c_linear_search( quad, geode::NO_ID ) )
+                        {
+                            continue;
+                        }
+                        quads.push_back( quad );
                     }
-                    builder_->create_polygon( polygon );
+                } );
+            for( const auto& quads : row_quads )
+            {
+                for( const auto& quad : quads )
+                {
+                    builder_->create_polygon( quad );
                 }
             }
         }
 
-        absl::FixedArray< geode::index_t > read_vertices()
+        std::vector< geode::index_t > read_vertices(
+            geode::index_t first_row, geode::index_t nb_rows )
         {
-            const auto nb_vertices = width_ * height_;
-            const auto nb_bands = dataset().GetRasterCount();
-            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
-                nb_bands > 0, nullptr, geode::OpenGeodeException::TYPE::data,
-                "[DEMInput] No bands found" );
-            absl::FixedArray< float > elevation( nb_vertices );
-            absl::FixedArray< geode::index_t > vertices(
-                nb_vertices, geode::NO_ID );
-            const auto band = dataset().GetRasterBand( 1 );
-            const auto status = band->RasterIO( GF_Read, 0, 0, width_, height_,
-                elevation.data(), width_, height_, GDT_Float32, 0, 0 );
-            const auto no_data_value = band->GetNoDataValue();
+            const auto nb_pixels =
+                static_cast< std::size_t >( width_ ) * nb_rows;
+            std::vector< float > elevation( nb_pixels );
+            const auto status = read_elevation( first_row, nb_rows, elevation );
             geode::OpenGeodeGeosciencesIOMeshException::check_exception(
                 status == CE_None, nullptr,
                 geode::OpenGeodeException::TYPE::internal,
                 "[DEMInput] Failed to read elevation" );
-            for( const auto i : geode::Range{ height_ } )
+            std::vector< geode::index_t > row_counts( nb_rows, 0 );
+            async::parallel_for( async::irange( geode::index_t{ 0 }, nb_rows ),
+                [&]( geode::index_t row ) {
+                    const auto begin = elevation.begin() + row * width_;
+                    row_counts[row] = static_cast< geode::index_t >(
+                        std::count_if( begin, begin + width_,
+                            [this]( float value ) {
+                                return value != no_data_value_;
+                            } ) );
+                } );
+            const auto nb_vertices = std::accumulate(
+                row_counts.begin(), row_counts.end(), geode::index_t{ 0 } );
+            const auto first_vertex = builder_->create_vertices( nb_vertices );
+            // Points are set sequentially: the builder is not thread-safe
+            std::vector< geode::index_t > vertices( nb_pixels, geode::NO_ID );
+            auto vertex = first_vertex;
+            for( const auto row : geode::Range{ nb_rows } )
             {
                 const auto i_contribution =
-                    coordinate_system_.direction( 1 ) * i;
+                    coordinate_system_.direction( 1 ) * ( first_row + row );
                 for( const auto j : geode::Range{ width_ } )
                 {
-                    const auto vertex = i * width_ + j;
-                    const auto current_elevation = elevation[vertex];
-                    if( current_elevation == no_data_value )
+                    const auto pixel = row * width_ + j;
+                    const auto current_elevation = elevation[pixel];
+                    if( current_elevation == no_data_value_ )
                     {
                         continue;
                     }
@@ -120,19 +186,60 @@ namespace
                         coordinate_system_.direction( 0 ) * j;
                     const auto point = coordinate_system_.origin()
                                        + i_contribution + j_contribution;
-                    vertices[vertex] = builder_->create_point(
-                        geode::Point3D{ { point.value( 0 ), point.value( 1 ),
-                            current_elevation } } );
+                    builder_->set_point(
+                        vertex, geode::Point3D{ { point.value( 0 ),
+                                    point.value( 1 ), current_elevation } } );
+                    vertices[pixel] = vertex++;
                 }
             }
             return vertices;
         }
 
-        void read_metadata()
+        // Level rows are read from the matching raster rows, GDAL picking an
+        // overview or resampling when both differ
+        CPLErr read_elevation( geode::index_t first_row, geode::index_t nb_rows,
+            std::vector< float >& elevation )
         {
-            coordinate_system_ = read_coordinate_system();
-            width_ = dataset().GetRasterXSize();
-            height_ = dataset().GetRasterYSize();
+            const auto row_height =
+                static_cast< double >( raster_height_ ) / height_;
+            GDALRasterIOExtraArg extra_arg;
+            INIT_RASTERIO_EXTRA_ARG( extra_arg );
+            extra_arg.bFloatingPointWindowValidity = TRUE;
+            extra_arg.dfXOff = 0;
+            extra_arg.dfXSize = raster_width_;
+            extra_arg.dfYOff = first_row * row_height;
+            extra_arg.dfYSize = nb_rows * row_height;
+            const auto raster_first_row =
+                static_cast< int >( std::floor( extra_arg.dfYOff ) );
+            const auto raster_end_row =
+                std::min( static_cast< int >( std::ceil(
+                              extra_arg.dfYOff + extra_arg.dfYSize ) ),
+                    static_cast< int >( raster_height_ ) );
+            return band_->RasterIO( GF_Read, 0, raster_first_row,
+                raster_width_, raster_end_row - raster_first_row,
+                elevation.data(), width_, nb_rows, GDT_Float32, 0, 0,
+                &extra_arg );
+        }
+
+        void read_metadata( const geode::internal::RasterLevelOptions& level )
+        {
+            raster_width_ = dataset().GetRasterXSize();
+            raster_height_ = dataset().GetRasterYSize();
+            const auto raster_coordinate_system = read_coordinate_system();
+            const auto level_size = geode::internal::raster_level_size(
+                dataset(), raster_coordinate_system, level );
+            width_ = level_size[0];
+            height_ = level_size[1];
+            coordinate_system_ =
+                geode::internal::raster_level_coordinate_system(
+                    raster_coordinate_system, { raster_width_, raster_height_ },
+                    level_size );
+            const auto nb_bands = dataset().GetRasterCount();
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                nb_bands > 0, nullptr, geode::OpenGeodeException::TYPE::data,
+                "[DEMInput] No bands found" );
+            band_ = dataset().GetRasterBand( 1 );
+            no_data_value_ = band_->GetNoDataValue();
         }
 
     private:
@@ -140,9 +247,12 @@ namespace
         geode::CoordinateSystem2D coordinate_system_;
         geode::index_t width_{ 0 };
         geode::index_t height_{ 0 };
+        geode::index_t raster_width_{ 0 };
+        geode::index_t raster_height_{ 0 };
+        GDALRasterBand* band_{ nullptr };
+        double no_data_value_{ 0 };
     };
 } // namespace
-
 namespace geode
 {
     namespace internal
@@ -151,19 +261,23 @@ namespace geode
             const MeshImpl& impl )
         {
             auto surface = PolygonalSurface3D::create( impl );
+            register_gdal_drivers();
+            const ScopedGDALConfiguration gdal_scope{ options_.gdal };
             DEMInputImpl reader{ *surface, this->filename() };
-            reader.read_file();
+            reader.read_file( options_.level );
             return surface;
         }
 
         auto DEMInput::additional_files() const -> AdditionalFiles
         {
+            register_gdal_drivers();
             detail::GDALFile reader{ this->filename() };
             return reader.additional_files< AdditionalFiles >();
         }
 
         Percentage DEMInput::is_loadable() const
         {
+            register_gdal_drivers();
             detail::GDALFile reader{ this->filename() };
             if( !reader.is_coordinate_system_loadable() )
             {
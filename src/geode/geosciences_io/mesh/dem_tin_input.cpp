@@ -0,0 +1,466 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/geosciences_io/mesh/internal/dem_tin_input.hpp>
+
+#include <async++.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <gdal.h>
+#include <gdal_priv.h>
+
+#include <geode/geometry/coordinate_system.hpp>
+#include <geode/geometry/point.hpp>
+#include <geode/geometry/vector.hpp>
+
+#include <geode/mesh/builder/triangulated_surface_builder.hpp>
+#include <geode/mesh/core/triangulated_surface.hpp>
+
+#include <geode/io/image/detail/gdal_file.hpp>
+
+#include <geode/geosciences_io/mesh/internal/dem_input.hpp>
+
+namespace
+{
+    // Number of pixels along each side of a tile, tiles share their borders.
+    // Must be a power of two.
+    static constexpr geode::index_t TILE_SIZE{ 256 };
+    // Depth of the smallest triangles whose hypotenuse middle is a pixel
+    static constexpr geode::index_t LEAF_DEPTH{ 15 };
+    static constexpr float INVALID_ERROR{
+        std::numeric_limits< float >::infinity()
+    };
+
+    using Pixel = std::array< geode::index_t, 2 >;
+    using Triangle = std::array< std::size_t, 3 >;
+
+    // Right isosceles triangle of a tile hierarchy, with its right angle at
+    // c. Splitting its hypotenuse ab at its middle gives its two children.
+    struct TileTriangle
+    {
+        Pixel a;
+        Pixel b;
+        Pixel c;
+    };
+
+    Pixel middle( const Pixel& a, const Pixel& b )
+    {
+        return { ( a[0] + b[0] ) / 2, ( a[1] + b[1] ) / 2 };
+    }
+
+    // Triangles of a tile are numbered as an implicit binary tree: the first
+    // bit after the leading one chooses one of the two tile halves and each
+    // following bit one of the two children.
+    TileTriangle tile_triangle( geode::index_t triangle )
+    {
+        auto id = triangle + 2;
+        TileTriangle result;
+        if( id & 1 )
+        {
+            result = { { 0, 0 }, { TILE_SIZE, TILE_SIZE }, { TILE_SIZE, 0 } };
+        }
+        else
+        {
+            result = { { TILE_SIZE, TILE_SIZE }, { 0, 0 }, { 0, TILE_SIZE } };
+        }
+        while( ( id >>= 1 ) > 1 )
+        {
+            const auto hypotenuse_middle = middle( result.a, result.b );
+            if( id & 1 )
+            {
+                result.b = result.a;
+                result.a = result.c;
+            }
+            else
+            {
+                result.a = result.b;
+                result.b = result.c;
+            }
+            result.c = hypotenuse_middle;
+        }
+        return result;
+    }
+
+    std::int64_t edge_function(
+        const Pixel& from, const Pixel& to, geode::index_t x, geode::index_t y )
+    {
+        return ( std::int64_t{ to[0] } - from[0] )
+                   * ( std::int64_t{ y } - from[1] )
+               - ( std::int64_t{ to[1] } - from[1] )
+                     * ( std::int64_t{ x } - from[0] );
+    }
+
+    class DEMTINInputImpl : public geode::detail::GDALFile
+    {
+    public:
+        DEMTINInputImpl(
+            geode::TriangulatedSurface3D& surface, std::string_view filename )
+            : geode::detail::GDALFile{ filename },
+              builder_{ geode::TriangulatedSurfaceBuilder3D::create( surface ) }
+        {
+        }
+
+        void read_file( const geode::internal::DEMTINInputOptions& options )
+        {
+            read_metadata( options.level );
+            read_elevations();
+            compute_errors();
+            const auto triangles =
+                extract_triangles( options.max_vertical_error );
+            create_mesh( triangles );
+        }
+
+    private:
+        std::size_t pixel_index( geode::index_t x, geode::index_t y ) const
+        {
+            return static_cast< std::size_t >( y ) * nb_columns_ + x;
+        }
+
+        bool is_valid( std::size_t pixel ) const
+        {
+            return !std::isnan( elevations_[pixel] );
+        }
+
+        void read_metadata( const geode::internal::RasterLevelOptions& level )
+        {
+            const auto nb_bands = dataset().GetRasterCount();
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                nb_bands > 0, nullptr, geode::OpenGeodeException::TYPE::data,
+                "[DEMTINInput] No bands found" );
+            raster_width_ = dataset().GetRasterXSize();
+            raster_height_ = dataset().GetRasterYSize();
+            const auto raster_coordinate_system = read_coordinate_system();
+            const auto level_size = geode::internal::raster_level_size(
+                dataset(), raster_coordinate_system, level );
+            width_ = level_size[0];
+            height_ = level_size[1];
+            coordinate_system_ =
+                geode::internal::raster_level_coordinate_system(
+                    raster_coordinate_system, { raster_width_, raster_height_ },
+                    level_size );
+            nb_tiles_[0] = std::max( ( width_ + TILE_SIZE - 2 ) / TILE_SIZE,
+                geode::index_t{ 1 } );
+            nb_tiles_[1] = std::max( ( height_ + TILE_SIZE - 2 ) / TILE_SIZE,
+                geode::index_t{ 1 } );
+            nb_columns_ = nb_tiles_[0] * TILE_SIZE + 1;
+            nb_rows_ = nb_tiles_[1] * TILE_SIZE + 1;
+        }
+
+        // Elevations are stored on the whole tiled area, pixels outside of
+        // the raster or without data being NaN
+        void read_elevations()
+        {
+            elevations_.assign( pixel_index( 0, nb_rows_ ),
+                std::numeric_limits< float >::quiet_NaN() );
+            const auto band = dataset().GetRasterBand( 1 );
+            const auto status = band->RasterIO( GF_Read, 0, 0, raster_width_,
+                raster_height_, elevations_.data(), width_, height_,
+                GDT_Float32, 0,
+                static_cast< GSpacing >( nb_columns_ * sizeof( float ) ) );
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                status == CE_None, nullptr,
+                geode::OpenGeodeException::TYPE::internal,
+                "[DEMTINInput] Failed to read elevation" );
+            const auto no_data_value = band->GetNoDataValue();
+            async::parallel_for( async::irange( geode::index_t{ 0 }, height_ ),
+                [this, no_data_value]( geode::index_t y ) {
+                    for( const auto x : geode::Range{ width_ } )
+                    {
+                        auto& elevation = elevations_[pixel_index( x, y )];
+                        if( elevation == no_data_value )
+                        {
+                            elevation =
+                                std::numeric_limits< float >::quiet_NaN();
+                        }
+                    }
+                } );
+        }
+
+        // Error of a triangle is the largest vertical distance between its
+        // pixels and its plane, or infinite if one of them has no data. It is
+        // stored on the middle of its hypotenuse, shared with the neighbour
+        // triangle, and includes the errors of all its descendants: splitting
+        // a triangle then always splits the triangles sharing its edges and
+        // the triangulation stays conforming.
+        // Triangles are processed from the smallest to the largest ones.
+        // Tiles are processed in parallel by groups not sharing any border.
+        void compute_errors()
+        {
+            errors_.assign( elevations_.size(), 0 );
+            std::array< std::vector< Pixel >, 4 > tile_groups;
+            for( const auto tile_y : geode::Range{ nb_tiles_[1] } )
+            {
+                for( const auto tile_x : geode::Range{ nb_tiles_[0] } )
+                {
+                    tile_groups[tile_x % 2 + 2 * ( tile_y % 2 )].push_back(
+                        { tile_x * TILE_SIZE, tile_y * TILE_SIZE } );
+                }
+            }
+            for( geode::index_t depth = LEAF_DEPTH + 1; depth-- > 0; )
+            {
+                const geode::index_t first_triangle = ( 2u << depth ) - 2;
+                const geode::index_t end_triangle = ( 4u << depth ) - 2;
+                for( const auto& tiles : tile_groups )
+                {
+                    async::parallel_for( tiles, [&]( const Pixel& tile ) {
+                        for( const auto triangle :
+                            geode::Range{ first_triangle, end_triangle } )
+                        {
+                            update_error( tile, tile_triangle( triangle ),
+                                depth != LEAF_DEPTH );
+                        }
+                    } );
+                }
+            }
+        }
+
+        void update_error( const Pixel& tile,
+            const TileTriangle& triangle,
+            bool has_children )
+        {
+            const auto global = [&tile]( const Pixel& pixel ) {
+                return Pixel{ tile[0] + pixel[0], tile[1] + pixel[1] };
+            };
+            const auto a = global( triangle.a );
+            const auto b = global( triangle.b );
+            const auto c = global( triangle.c );
+            auto error = plane_error( a, b, c );
+            if( has_children )
+            {
+                const auto left = middle( c, a );
+                const auto right = middle( b, c );
+                error = std::max( { error,
+                    errors_[pixel_index( left[0], left[1] )],
+                    errors_[pixel_index( right[0], right[1] )] } );
+            }
+            const auto hypotenuse_middle = middle( a, b );
+            auto& middle_error = errors_[pixel_index(
+                hypotenuse_middle[0], hypotenuse_middle[1] )];
+            middle_error = std::max( middle_error, error );
+        }
+
+        float plane_error(
+            const Pixel& a, const Pixel& b, const Pixel& c ) const
+        {
+            const auto area = edge_function( a, b, c[0], c[1] );
+            const auto elevation_a = elevations_[pixel_index( a[0], a[1] )];
+            const auto elevation_b = elevations_[pixel_index( b[0], b[1] )];
+            const auto elevation_c = elevations_[pixel_index( c[0], c[1] )];
+            const auto min_x = std::min( { a[0], b[0], c[0] } );
+            const auto max_x = std::max( { a[0], b[0], c[0] } );
+            const auto min_y = std::min( { a[1], b[1], c[1] } );
+            const auto max_y = std::max( { a[1], b[1], c[1] } );
+            float error{ 0 };
+            for( const auto y : geode::Range{ min_y, max_y + 1 } )
+            {
+                for( const auto x : geode::Range{ min_x, max_x + 1 } )
+                {
+                    const auto weight_a = edge_function( b, c, x, y );
+                    const auto weight_b = edge_function( c, a, x, y );
+                    const auto weight_c = edge_function( a, b, x, y );
+                    if( weight_a * area < 0 || weight_b * area < 0
+                        || weight_c * area < 0 )
+                    {
+                        continue;
+                    }
+                    const auto pixel = pixel_index( x, y );
+                    if( !is_valid( pixel ) )
+                    {
+                        return INVALID_ERROR;
+                    }
+                    const auto plane_elevation =
+                        ( weight_a * static_cast< double >( elevation_a )
+                            + weight_b * static_cast< double >( elevation_b )
+                            + weight_c * static_cast< double >( elevation_c ) )
+                        / area;
+                    error = std::max( error,
+                        static_cast< float >( std::fabs(
+                            plane_elevation - elevations_[pixel] ) ) );
+                }
+            }
+            return error;
+        }
+
+        std::vector< std::vector< Triangle > > extract_triangles(
+            double max_error ) const
+        {
+            std::vector< std::vector< Triangle > > tile_triangles(
+                std::size_t{ nb_tiles_[0] } * nb_tiles_[1] );
+            async::parallel_for(
+                async::irange( std::size_t{ 0 }, tile_triangles.size() ),
+                [this, max_error, &tile_triangles]( std::size_t tile ) {
+                    const Pixel origin{
+                        static_cast< geode::index_t >( tile % nb_tiles_[0] )
+                            * TILE_SIZE,
+                        static_cast< geode::index_t >( tile / nb_tiles_[0] )
+                            * TILE_SIZE
+                    };
+                    auto& triangles = tile_triangles[tile];
+                    for( const auto root : { 0u, 1u } )
+                    {
+                        const auto triangle = tile_triangle( root );
+                        const auto global = [&origin]( const Pixel& pixel ) {
+                            return Pixel{ origin[0] + pixel[0],
+                                origin[1] + pixel[1] };
+                        };
+                        extract_triangle( global( triangle.a ),
+                            global( triangle.b ), global( triangle.c ),
+                            max_error, triangles );
+                    }
+                } );
+            return tile_triangles;
+        }
+
+        void extract_triangle( const Pixel& a,
+            const Pixel& b,
+            const Pixel& c,
+            double max_error,
+            std::vector< Triangle >& triangles ) const
+        {
+            const auto hypotenuse_middle = middle( a, b );
+            const auto leg_length = ( std::max( a[0], c[0] )
+                                        - std::min( a[0], c[0] ) )
+                                    + ( std::max( a[1], c[1] )
+                                        - std::min( a[1], c[1] ) );
+            if( leg_length > 1
+                && errors_[pixel_index(
+                       hypotenuse_middle[0], hypotenuse_middle[1] )]
+                       > max_error )
+            {
+                extract_triangle( c, a, hypotenuse_middle, max_error,
+                    triangles );
+                extract_triangle( b, c, hypotenuse_middle, max_error,
+                    triangles );
+                return;
+            }
+            // Same orientation as the DEMInput quads
+            const Triangle triangle{ pixel_index( a[0], a[1] ),
+                pixel_index( c[0], c[1] ), pixel_index( b[0], b[1] ) };
+            for( const auto pixel : triangle )
+            {
+                if( !is_valid( pixel ) )
+                {
+                    return;
+                }
+            }
+            triangles.push_back( triangle );
+        }
+
+        void create_mesh(
+            const std::vector< std::vector< Triangle > >& tile_triangles )
+        {
+            errors_ = {};
+            std::vector< geode::index_t > vertices(
+                elevations_.size(), geode::NO_ID );
+            std::vector< std::size_t > vertex_pixels;
+            for( const auto& triangles : tile_triangles )
+            {
+                for( const auto& triangle : triangles )
+                {
+                    for( const auto pixel : triangle )
+                    {
+                        if( vertices[pixel] == geode::NO_ID )
+                        {
+                            vertices[pixel] = static_cast< geode::index_t >(
+                                vertex_pixels.size() );
+                            vertex_pixels.push_back( pixel );
+                        }
+                    }
+                }
+            }
+            const auto nb_vertices =
+                static_cast< geode::index_t >( vertex_pixels.size() );
+            builder_->create_vertices( nb_vertices );
+            // Points are set sequentially: the builder is not thread-safe
+            for( const auto vertex : geode::Range{ nb_vertices } )
+            {
+                const auto pixel = vertex_pixels[vertex];
+                const auto point =
+                    coordinate_system_.origin()
+                    + coordinate_system_.direction( 0 )
+                          * static_cast< double >( pixel % nb_columns_ )
+                    + coordinate_system_.direction( 1 )
+                          * static_cast< double >( pixel / nb_columns_ );
+                builder_->set_point( vertex,
+                    geode::Point3D{ { point.value( 0 ), point.value( 1 ),
+                        elevations_[pixel] } } );
+            }
+            for( const auto& triangles : tile_triangles )
+            {
+                for( const auto& triangle : triangles )
+                {
+                    builder_->create_triangle( { vertices[triangle[0]],
+                        vertices[triangle[1]], vertices[triangle[2]] } );
+                }
+            }
+        }
+
+    private:
+        std::unique_ptr< geode::TriangulatedSurfaceBuilder3D > builder_;
+        geode::CoordinateSystem2D coordinate_system_;
+        geode::index_t width_{ 0 };
+        geode::index_t height_{ 0 };
+        geode::index_t raster_width_{ 0 };
+        geode::index_t raster_height_{ 0 };
+        std::array< geode::index_t, 2 > nb_tiles_{ { 0, 0 } };
+        geode::index_t nb_columns_{ 0 };
+        geode::index_t nb_rows_{ 0 };
+        std::vector< float > elevations_;
+        std::vector< float > errors_;
+    };
+} // namespace
+
+namespace geode
+{
+    namespace internal
+    {
+        std::unique_ptr< TriangulatedSurface3D > DEMTINInput::read(
+            const MeshImpl& impl )
+        {
+            auto surface = TriangulatedSurface3D::create( impl );
+            register_gdal_drivers();
+            const ScopedGDALConfiguration gdal_scope{ options_.gdal };
+            DEMTINInputImpl reader{ *surface, this->filename() };
+            reader.read_file( options_ );
+            return surface;
+        }
+
+        auto DEMTINInput::additional_files() const -> AdditionalFiles
+        {
+            register_gdal_drivers();
+            detail::GDALFile reader{ this->filename() };
+            return reader.additional_files< AdditionalFiles >();
+        }
+
+        Percentage DEMTINInput::is_loadable() const
+        {
+            return DEMInput{ this->filename() }.is_loadable();
+        }
+    } // namespace internal
+} // namespace geode
@@ -0,0 +1,504 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/geosciences_io/mesh/internal/egrid_input.hpp>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <absl/algorithm/container.h>
+#include <absl/strings/ascii.h>
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_cat.h>
+
+#include <geode/basic/file.hpp>
+#include <geode/basic/filename.hpp>
+#include <geode/basic/string.hpp>
+
+#include <geode/mesh/core/hybrid_solid.hpp>
+
+namespace
+{
+    // Eclipse binary files are big-endian Fortran unformatted files: each
+    // Fortran record is surrounded by its size in bytes. An array is made of
+    // a 16-byte header record (keyword, number of values, value type)
+    // followed by data records of at most 1000 values.
+    static constexpr std::uint32_t HEADER_SIZE{ 16 };
+    static constexpr std::array< std::string_view, 3 > HEADER_KEYWORDS{
+        "INTEHEAD", "LOGIHEAD", "DOUBHEAD"
+    };
+
+    enum struct VALUE_TYPE
+    {
+        integer,
+        real,
+        double_precision,
+        logical,
+        character,
+        message
+    };
+
+    struct RecordHeader
+    {
+        std::string keyword;
+        geode::index_t nb_values{ 0 };
+        VALUE_TYPE type{ VALUE_TYPE::message };
+        std::uint32_t value_size{ 0 };
+    };
+
+    std::uint32_t big_endian_uint32( const char* bytes )
+    {
+        const auto* data = reinterpret_cast< const unsigned char* >( bytes );
+        return ( std::uint32_t{ data[0] } << 24 )
+               | ( std::uint32_t{ data[1] } << 16 )
+               | ( std::uint32_t{ data[2] } << 8 ) | std::uint32_t{ data[3] };
+    }
+
+    std::uint64_t big_endian_uint64( const char* bytes )
+    {
+        return ( std::uint64_t{ big_endian_uint32( bytes ) } << 32 )
+               | big_endian_uint32( bytes + 4 );
+    }
+
+    double decode_value( const char* bytes, VALUE_TYPE type )
+    {
+        switch( type )
+        {
+        case VALUE_TYPE::integer:
+            return static_cast< std::int32_t >( big_endian_uint32( bytes ) );
+        case VALUE_TYPE::logical:
+            return big_endian_uint32( bytes ) != 0 ? 1 : 0;
+        case VALUE_TYPE::real:
+        {
+            const auto bits = big_endian_uint32( bytes );
+            float value;
+            std::memcpy( &value, &bits, sizeof( value ) );
+            return value;
+        }
+        case VALUE_TYPE::double_precision:
+        {
+            const auto bits = big_endian_uint64( bytes );
+            double value;
+            std::memcpy( &value, &bits, sizeof( value ) );
+            return value;
+        }
+        default:
+            throw geode::OpenGeodeGeosciencesIOMeshException{ nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[EGRIDInput] Cannot decode non numeric values" };
+        }
+    }
+
+    std::pair< VALUE_TYPE, std::uint32_t > value_type(
+        std::string_view type )
+    {
+        if( type == "INTE" )
+        {
+            return { VALUE_TYPE::integer, 4 };
+        }
+        if( type == "REAL" )
+        {
+            return { VALUE_TYPE::real, 4 };
+        }
+        if( type == "DOUB" )
+        {
+            return { VALUE_TYPE::double_precision, 8 };
+        }
+        if( type == "LOGI" )
+        {
+            return { VALUE_TYPE::logical, 4 };
+        }
+        if( type == "CHAR" )
+        {
+            return { VALUE_TYPE::character, 8 };
+        }
+        if( type == "MESS" )
+        {
+            return { VALUE_TYPE::message, 0 };
+        }
+        std::uint32_t size;
+        if( type[0] == 'C' && absl::SimpleAtoi( type.substr( 1 ), &size ) )
+        {
+            return { VALUE_TYPE::character, size };
+        }
+        throw geode::OpenGeodeGeosciencesIOMeshException{ nullptr,
+            geode::OpenGeodeException::TYPE::data,
+            "[EGRIDInput] Unknown value type ", type };
+    }
+
+    bool is_numeric( const RecordHeader& header )
+    {
+        return header.type != VALUE_TYPE::character
+               && header.type != VALUE_TYPE::message;
+    }
+
+    class EclipseBinaryFile
+    {
+    public:
+        explicit EclipseBinaryFile( const std::string& filename )
+            : file_{ filename, std::ios::binary }
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                file_.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+                "[EGRIDInput] Cannot open file ", filename );
+        }
+
+        // Returns std::nullopt at the end of the file
+        std::optional< RecordHeader > next_header()
+        {
+            const auto size = read_record_size();
+            if( !size )
+            {
+                return std::nullopt;
+            }
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                size == HEADER_SIZE, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[EGRIDInput] Invalid array header" );
+            std::array< char, HEADER_SIZE > bytes;
+            read_record( bytes.data(), HEADER_SIZE );
+            RecordHeader header;
+            header.keyword = std::string{ absl::StripTrailingAsciiWhitespace(
+                std::string_view{ bytes.data(), 8 } ) };
+            header.nb_values = big_endian_uint32( bytes.data() + 8 );
+            std::tie( header.type, header.value_size ) =
+                value_type( std::string_view{ bytes.data() + 12, 4 } );
+            return header;
+        }
+
+        // Calls set_value( value_id, value ) for each value of the array.
+        // Each data record is read at once and decoded from its bytes.
+        template < typename Setter >
+        void read_values( const RecordHeader& header, Setter&& set_value )
+        {
+            geode::index_t value_id{ 0 };
+            while( value_id < header.nb_values )
+            {
+                const auto size = next_data_record_size( header, value_id );
+                buffer_.resize( size );
+                read_record( buffer_.data(), size );
+                for( std::uint32_t offset = 0; offset < size;
+                     offset += header.value_size )
+                {
+                    set_value( value_id++,
+                        decode_value( &buffer_[offset], header.type ) );
+                }
+            }
+        }
+
+        void skip_values( const RecordHeader& header )
+        {
+            geode::index_t value_id{ 0 };
+            while( value_id < header.nb_values )
+            {
+                const auto size = next_data_record_size( header, value_id );
+                file_.seekg( size, std::ios::cur );
+                check_record_end( size );
+                value_id += size / header.value_size;
+            }
+        }
+
+    private:
+        std::optional< std::uint32_t > read_record_size()
+        {
+            std::array< char, 4 > bytes;
+            if( !file_.read( bytes.data(), bytes.size() ) )
+            {
+                return std::nullopt;
+            }
+            return big_endian_uint32( bytes.data() );
+        }
+
+        // Called while values remain: an empty record would not progress
+        std::uint32_t next_data_record_size(
+            const RecordHeader& header, geode::index_t nb_read_values )
+        {
+            const auto size = read_record_size();
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                size && size.value() != 0 && header.value_size != 0
+                    && size.value() % header.value_size == 0
+                    && size.value() / header.value_size
+                           <= header.nb_values - nb_read_values,
+                nullptr, geode::OpenGeodeException::TYPE::data,
+                "[EGRIDInput] Invalid data record for ", header.keyword );
+            return size.value();
+        }
+
+        void read_record( char* bytes, std::uint32_t size )
+        {
+            file_.read( bytes, size );
+            check_record_end( size );
+        }
+
+        void check_record_end( std::uint32_t size )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                read_record_size() == size, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[EGRIDInput] Truncated or corrupted record" );
+        }
+
+    private:
+        std::ifstream file_;
+        std::vector< char > buffer_;
+    };
+
+    std::string init_filename( std::string_view filename )
+    {
+        const auto path =
+            geode::filepath_without_extension( filename ).string();
+        const auto lower_case = absl::StrCat( path, ".init" );
+        if( geode::file_exists( lower_case ) )
+        {
+            return lower_case;
+        }
+        return absl::StrCat( path, ".INIT" );
+    }
+
+    class EGRIDInputImpl
+    {
+    public:
+        explicit EGRIDInputImpl( std::string_view filename )
+            : filename_{ geode::to_string( filename ) }
+        {
+        }
+
+        geode::internal::CornerPointGrid read_file()
+        {
+            auto grid = read_grid();
+            const auto init_file = init_filename( filename_ );
+            if( geode::file_exists( init_file ) )
+            {
+                read_properties( grid, init_file );
+            }
+            return grid;
+        }
+
+    private:
+        geode::internal::CornerPointGrid read_grid() const
+        {
+            EclipseBinaryFile file{ filename_ };
+            std::optional< geode::internal::CornerPointGrid > grid;
+            bool has_coordinates{ false };
+            bool has_depths{ false };
+            while( const auto header = file.next_header() )
+            {
+                if( header->keyword == "ENDGRID" )
+                {
+                    break;
+                }
+                if( header->keyword == "GRIDHEAD" )
+                {
+                    const auto nb_cells = read_grid_header( file, *header );
+                    grid.emplace( nb_cells[0], nb_cells[1], nb_cells[2] );
+                }
+                else if( grid && header->keyword == "COORD" )
+                {
+                    read_array( file, *header,
+                        grid->modifiable_pillar_coordinates() );
+                    has_coordinates = true;
+                }
+                else if( grid && header->keyword == "ZCORN" )
+                {
+                    read_array(
+                        file, *header, grid->modifiable_corner_depths() );
+                    has_depths = true;
+                }
+                else if( grid && header->keyword == "ACTNUM" )
+                {
+                    read_active_cells( file, *header, *grid );
+                }
+                else
+                {
+                    file.skip_values( *header );
+                }
+            }
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                grid && has_coordinates && has_depths, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[EGRIDInput::read_grid] Missing GRIDHEAD, COORD or ZCORN "
+                "array" );
+            return std::move( grid.value() );
+        }
+
+        static std::array< geode::index_t, 3 > read_grid_header(
+            EclipseBinaryFile& file, const RecordHeader& header )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                is_numeric( header ) && header.nb_values >= 4, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[EGRIDInput::read_grid_header] Invalid GRIDHEAD array" );
+            std::vector< double > values( header.nb_values );
+            file.read_values(
+                header, [&values]( geode::index_t id, double value ) {
+                    values[id] = value;
+                } );
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                values[0] == 1, nullptr, geode::OpenGeodeException::TYPE::data,
+                "[EGRIDInput::read_grid_header] Only corner-point grids are "
+                "supported" );
+            return { static_cast< geode::index_t >( values[1] ),
+                static_cast< geode::index_t >( values[2] ),
+                static_cast< geode::index_t >( values[3] ) };
+        }
+
+        static void read_array( EclipseBinaryFile& file,
+            const RecordHeader& header,
+            absl::Span< double > values )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                is_numeric( header ) && header.nb_values == values.size(),
+                nullptr, geode::OpenGeodeException::TYPE::data,
+                "[EGRIDInput::read_array] Wrong number of values in ",
+                header.keyword );
+            file.read_values(
+                header, [&values]( geode::index_t id, double value ) {
+                    values[id] = value;
+                } );
+        }
+
+        static void read_active_cells( EclipseBinaryFile& file,
+            const RecordHeader& header,
+            geode::internal::CornerPointGrid& grid )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                is_numeric( header ) && header.nb_values == grid.nb_cells(),
+                nullptr, geode::OpenGeodeException::TYPE::data,
+                "[EGRIDInput::read_active_cells] Wrong number of ACTNUM "
+                "values" );
+            std::vector< bool > is_active( grid.nb_cells() );
+            file.read_values(
+                header, [&is_active]( geode::index_t cell, double value ) {
+                    is_active[cell] = value != 0;
+                } );
+            grid.set_active_cells( std::move( is_active ) );
+        }
+
+        // INIT arrays are given either for all the cells or for the active
+        // cells only. Inactive cells get a zero value in the latter case.
+        static void read_properties( geode::internal::CornerPointGrid& grid,
+            const std::string& init_file )
+        {
+            std::vector< geode::index_t > active_cells;
+            active_cells.reserve( grid.nb_active_cells() );
+            for( const auto cell : geode::Range{ grid.nb_cells() } )
+            {
+                if( grid.is_cell_active( cell ) )
+                {
+                    active_cells.push_back( cell );
+                }
+            }
+            EclipseBinaryFile file{ init_file };
+            while( const auto header = file.next_header() )
+            {
+                if( header->keyword == "LGR" )
+                {
+                    break;
+                }
+                if( !is_cell_property( *header, grid ) )
+                {
+                    file.skip_values( *header );
+                    continue;
+                }
+                std::vector< double > values( grid.nb_cells(), 0 );
+                if( header->nb_values == grid.nb_cells() )
+                {
+                    file.read_values( *header,
+                        [&values]( geode::index_t cell, double value ) {
+                            values[cell] = value;
+                        } );
+                }
+                else
+                {
+                    file.read_values( *header,
+                        [&values, &active_cells](
+                            geode::index_t id, double value ) {
+                            values[active_cells[id]] = value;
+                        } );
+                }
+                grid.add_cell_property( header->keyword, std::move( values ) );
+            }
+        }
+
+        static bool is_cell_property( const RecordHeader& header,
+            const geode::internal::CornerPointGrid& grid )
+        {
+            if( !is_numeric( header )
+                || absl::c_linear_search( HEADER_KEYWORDS, header.keyword ) )
+            {
+                return false;
+            }
+            return header.nb_values == grid.nb_cells()
+                   || header.nb_values == grid.nb_active_cells();
+        }
+
+    private:
+        std::string filename_;
+    };
+} // namespace
+
+namespace geode
+{
+    namespace internal
+    {
+        std::unique_ptr< HybridSolid3D > EGRIDInput::read(
+            const MeshImpl& impl )
+        {
+            return read_corner_point_grid().hybrid_solid( impl, false );
+        }
+
+        CornerPointGrid EGRIDInput::read_corner_point_grid() const
+        {
+            EGRIDInputImpl reader{ this->filename() };
+            return reader.read_file();
+        }
+
+        auto EGRIDInput::additional_files() const -> AdditionalFiles
+        {
+            const auto init_file = init_filename( this->filename() );
+            AdditionalFiles missing;
+            missing.optional_files.emplace_back(
+                init_file, file_exists( init_file ) );
+            return missing;
+        }
+
+        Percentage EGRIDInput::is_loadable() const
+        {
+            std::ifstream file{ to_string( this->filename() ),
+                std::ios::binary };
+            std::array< char, 4 > size;
+            if( file.read( size.data(), size.size() )
+                && big_endian_uint32( size.data() ) == HEADER_SIZE )
+            {
+                return Percentage{ 1 };
+            }
+            return Percentage{ 0 };
+        }
+    } // namespace internal
+} // namespace geode
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include <geode/geosciences_io/mesh/internal/gdal_configuration.hpp>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <set>
+
+#include <cpl_conv.h>
+#include <gdal.h>
+#include <gdal_priv.h>
+
+namespace
+{
+    GIntBig cache_size( geode::index_t megabytes )
+    {
+        return static_cast< GIntBig >( megabytes ) * 1024 * 1024;
+    }
+
+    /*!
+     * Process-wide block cache size, shared by the library configuration and
+     * the scoped ones: the cache is the largest of the library size and the
+     * sizes requested by the active scopes.
+     */
+    class GDALCacheSize
+    {
+    public:
+        static GDALCacheSize& instance()
+        {
+            static GDALCacheSize cache_size;
+            return cache_size;
+        }
+
+        void set_library_size( GIntBig size )
+        {
+            std::lock_guard< std::mutex > lock{ mutex_ };
+            library_size_ = size;
+            apply();
+        }
+
+        void add_scope_size( GIntBig size )
+        {
+            std::lock_guard< std::mutex > lock{ mutex_ };
+            if( scope_sizes_.empty() && !library_size_ )
+            {
+                library_size_ = GDALGetCacheMax64();
+            }
+            scope_sizes_.insert( size );
+            apply();
+        }
+
+        void remove_scope_size( GIntBig size )
+        {
+            std::lock_guard< std::mutex > lock{ mutex_ };
+            scope_sizes_.erase( scope_sizes_.find( size ) );
+            apply();
+        }
+
+    private:
+        void apply()
+        {
+            auto size = library_size_.value_or( GDALGetCacheMax64() );
+            if( !scope_sizes_.empty() )
+            {
+                size = std::max( size, *scope_sizes_.rbegin() );
+            }
+            GDALSetCacheMax64( size );
+        }
+
+    private:
+        std::mutex mutex_;
+        std::optional< GIntBig > library_size_;
+        std::multiset< GIntBig > scope_sizes_;
+    };
+
+    // Names of the GDAL drivers used by the readers and writers
+    constexpr std::array< const char*, 5 > LIBRARY_DRIVERS{ "GTiff",
+        "USGSDEM", "AAIGrid", "EHdr", "ESRI Shapefile" };
+
+    std::vector< std::pair< std::string, std::string > > config_options(
+        const geode::internal::GDALConfiguration& configuration )
+    {
+        auto options = configuration.options;
+        if( configuration.num_threads )
+        {
+            options.emplace_back(
+                "GDAL_NUM_THREADS", configuration.num_threads.value() );
+        }
+        return options;
+    }
+} // namespace
+
+namespace geode
+{
+    namespace internal
+    {
+        void register_gdal_drivers()
+        {
+            static std::once_flag registered;
+            std::call_once( registered, [] {
+                auto* manager = GetGDALDriverManager();
+                for( const auto* driver : LIBRARY_DRIVERS )
+                {
+                    if( !manager->GetDriverByName( driver ) )
+                    {
+                        GDALAllRegister();
+                        return;
+                    }
+                }
+            } );
+        }
+
+        void register_all_gdal_drivers()
+        {
+            GDALAllRegister();
+        }
+
+        void set_gdal_configuration( const GDALConfiguration& configuration )
+        {
+            for( const auto& [key, value] : config_options( configuration ) )
+            {
+                CPLSetConfigOption( key.c_str(), value.c_str() );
+            }
+            if( configuration.cache_max )
+            {
+                GDALCacheSize::instance().set_library_size(
+                    cache_size( configuration.cache_max.value() ) );
+            }
+        }
+
+        ScopedGDALConfiguration::ScopedGDALConfiguration(
+            const GDALConfiguration& configuration )
+            : cache_max_( configuration.cache_max )
+        {
+            for( const auto& [key, value] : config_options( configuration ) )
+            {
+                const auto* previous =
+                    CPLGetThreadLocalConfigOption( key.c_str(), nullptr );
+                previous_options_.emplace_back( key,
+                    previous ? std::optional< std::string >{ previous }
+                             : std::nullopt );
+                CPLSetThreadLocalConfigOption( key.c_str(), value.c_str() );
+            }
+            if( cache_max_ )
+            {
+                GDALCacheSize::instance().add_scope_size(
+                    cache_size( cache_max_.value() ) );
+            }
+        }
+
+        ScopedGDALConfiguration::~ScopedGDALConfiguration()
+        {
+            for( auto it = previous_options_.rbegin();
+                 it != previous_options_.rend(); ++it )
+            {
+                CPLSetThreadLocalConfigOption( it->first.c_str(),
+                    it->second ? it->second->c_str() : nullptr );
+            }
+            if( cache_max_ )
+            {
+                GDALCacheSize::instance().remove_scope_size(
+                    cache_size( cache_max_.value() ) );
+            }
+        }
+    } // namespace internal
+} // namespace geode
@@ -23,17 +23,32 @@
 
 #include <geode/geosciences_io/mesh/internal/geotiff_input.hpp>
 
+#include <async++.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <absl/strings/str_cat.h>
+
 #include <gdal_priv.h>
 
+#include <geode/basic/attribute_manager.hpp>
 #include <geode/basic/file.hpp>
 #include <geode/basic/filename.hpp>
-#include <geode/basic/logger.hpp>
+#include <geode/basic/pimpl_impl.hpp>
+#include <geode/basic/variable_attribute.hpp>
 
 #include <geode/geometry/coordinate_system.hpp>
 #include <geode/geometry/point.hpp>
 #include <geode/geometry/vector.hpp>
 
 #include <geode/image/core/raster_image.hpp>
+#include <geode/image/core/rgb_color.hpp>
 #include <geode/image/io/raster_image_input.hpp>
 
 #include <geode/mesh/core/light_regular_grid.hpp>
@@ -41,8 +56,130 @@
 
 #include <geode/io/image/detail/gdal_file.hpp>
 
+#include <geode/geosciences_io/mesh/internal/grid_window.hpp>
+#include <geode/geosciences_io/mesh/internal/raster_level.hpp>
+
 namespace
 {
+    // Coordinates of the point in the raster, where pixel i spans from i to
+    // i + 1
+    std::array< double, 2 > pixel_coordinates(
+        const geode::CoordinateSystem2D& coordinate_system,
+        const geode::Point2D& point )
+    {
+        const auto& u = coordinate_system.direction( 0 );
+        const auto& v = coordinate_system.direction( 1 );
+        const geode::Vector2D p{ coordinate_system.origin(), point };
+        const auto determinant =
+            u.value( 0 ) * v.value( 1 ) - u.value( 1 ) * v.value( 0 );
+        return { ( p.value( 0 ) * v.value( 1 ) - p.value( 1 ) * v.value( 0 ) )
+                     / determinant,
+            ( u.value( 0 ) * p.value( 1 ) - u.value( 1 ) * p.value( 0 ) )
+                / determinant };
+    }
+
+    // Raster pixels read into the grid cells
+    struct RasterSampling
+    {
+        geode::internal::GridWindow< 2 > window;
+        std::array< geode::index_t, 2 > pixels_number;
+        geode::CoordinateSystem2D coordinate_system;
+
+        // Size of the raster part read
+        std::array< geode::index_t, 2 > source_size() const
+        {
+            return { window.nb_cells( 0 ) * window.stride(),
+                window.nb_cells( 1 ) * window.stride() };
+        }
+
+        // Raster pixel read for the given cell: the middle one of those
+        // covered by the cell, as GDAL nearest neighbour downsampling does
+        std::array< geode::index_t, 2 > raster_pixel(
+            geode::index_t cell ) const
+        {
+            const std::array< geode::index_t, 2 > cell_indices{
+                cell % pixels_number[0], cell / pixels_number[0]
+            };
+            const auto source = source_size();
+            std::array< geode::index_t, 2 > pixel;
+            for( const auto d : geode::LRange{ 2 } )
+            {
+                pixel[d] = window.begin( d )
+                           + static_cast< geode::index_t >(
+                               ( 2 * std::uint64_t{ cell_indices[d] } + 1 )
+                               * source[d] / ( 2 * pixels_number[d] ) );
+            }
+            return pixel;
+        }
+    };
+
+    template < typename Type >
+    void read_band_values( GDALRasterBand& band,
+        GDALDataType type,
+        const RasterSampling& sampling,
+        geode::LightRegularGrid2D& grid,
+        std::string_view name )
+    {
+        const auto& pixels_number = sampling.pixels_number;
+        const auto source = sampling.source_size();
+        std::vector< Type > values(
+            std::size_t{ pixels_number[0] } * pixels_number[1] );
+        const auto status = band.RasterIO( GF_Read,
+            sampling.window.begin( 0 ), sampling.window.begin( 1 ), source[0],
+            source[1], values.data(), pixels_number[0], pixels_number[1],
+            type, 0, 0 );
+        geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+            status == CE_None, nullptr,
+            geode::OpenGeodeException::TYPE::internal,
+            "[GEOTIFFInput] Failed to read band ", name );
+        auto attribute =
+            grid.cell_attribute_manager()
+                .find_or_create_attribute< geode::VariableAttribute, Type >(
+                    name, Type{} );
+        async::parallel_for(
+            async::irange( geode::index_t{ 0 }, pixels_number[1] ),
+            [&]( geode::index_t row ) {
+                const auto first_cell = row * pixels_number[0];
+                for( const auto cell : geode::Range{
+                         first_cell, first_cell + pixels_number[0] } )
+                {
+                    attribute->set_value( cell, values[cell] );
+                }
+            } );
+    }
+
+    // Reads the band into a cell attribute of the same type
+    void read_band_attribute( GDALRasterBand& band,
+        const RasterSampling& sampling,
+        geode::LightRegularGrid2D& grid,
+        std::string_view name )
+    {
+        switch( band.GetRasterDataType() )
+        {
+        case GDT_Byte:
+            return read_band_values< std::uint8_t >(
+                band, GDT_Byte, sampling, grid, name );
+        case GDT_Int16:
+            return read_band_values< std::int16_t >(
+                band, GDT_Int16, sampling, grid, name );
+        case GDT_UInt16:
+            return read_band_values< std::uint16_t >(
+                band, GDT_UInt16, sampling, grid, name );
+        case GDT_Int32:
+            return read_band_values< std::int32_t >(
+                band, GDT_Int32, sampling, grid, name );
+        case GDT_UInt32:
+            return read_band_values< std::uint32_t >(
+                band, GDT_UInt32, sampling, grid, name );
+        case GDT_Float32:
+            return read_band_values< float >(
+                band, GDT_Float32, sampling, grid, name );
+        default:
+            return read_band_values< double >(
+                band, GDT_Float64, sampling, grid, name );
+        }
+    }
+
     class GEOTIFFInputImpl : public geode::detail::GDALFile
     {
     public:
@@ -51,19 +188,191 @@ namespace
         {
         }
 
-        geode::LightRegularGrid2D read_file()
+        geode::LightRegularGrid2D read_file(
+            const geode::internal::GEOTIFFInputOptions& options )
         {
-            const auto level = geode::Logger::level();
-            geode::Logger::set_level( geode::Logger::LEVEL::critical );
-            const auto raster = geode::load_raster_image< 2 >( filename_ );
-            geode::Logger::set_level( level );
-            const auto cooridinate_system = read_coordinate_system();
+            const auto sampling = this->sampling( options );
+            if( options.band_attributes || options.lazy_bands )
+            {
+                auto grid = empty_grid( sampling );
+                if( !options.lazy_bands )
+                {
+                    for( const auto band : geode::Range{ nb_bands() } )
+                    {
+                        read_band_attribute( raster_band( band ), sampling,
+                            grid,
+                            geode::internal::GEOTIFFBandReader::attribute_name(
+                                band ) );
+                    }
+                }
+                return grid;
+            }
+            if( !sampling.window.is_whole_grid( raster_size() )
+                || !options.level.is_native() )
+            {
+                return geode::convert_raster_image_into_grid(
+                    read_raster_window( sampling ),
+                    sampling.coordinate_system );
+            }
             return geode::convert_raster_image_into_grid(
-                raster, cooridinate_system );
+                geode::load_raster_image< 2 >( filename_ ),
+                sampling.coordinate_system );
+        }
+
+        RasterSampling sampling(
+            const geode::internal::GEOTIFFInputOptions& options )
+        {
+            const auto coordinate_system = read_coordinate_system();
+            const auto cells_number = raster_size();
+            geode::internal::GridWindow< 2 > window{ options.window,
+                cells_number,
+                [&coordinate_system]( const geode::Point2D& point ) {
+                    return pixel_coordinates( coordinate_system, point );
+                } };
+            const auto level_size = geode::internal::raster_level_size(
+                dataset(), coordinate_system, options.level );
+            const auto pixels_number =
+                window_pixels_number( window, cells_number, level_size );
+            auto sampling_coordinate_system = window_coordinate_system(
+                coordinate_system, window, pixels_number );
+            return { std::move( window ), pixels_number,
+                std::move( sampling_coordinate_system ) };
+        }
+
+        geode::index_t nb_bands()
+        {
+            const auto nb_bands = dataset().GetRasterCount();
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                nb_bands > 0, nullptr, geode::OpenGeodeException::TYPE::data,
+                "[GEOTIFFInput] No bands found" );
+            return static_cast< geode::index_t >( nb_bands );
+        }
+
+        GDALRasterBand& raster_band( geode::index_t band )
+        {
+            return *dataset().GetRasterBand( static_cast< int >( band ) + 1 );
+        }
+
+        // GDAL overview of the bands having the size of the level, if any
+        std::optional< int > level_overview(
+            const geode::internal::RasterLevelOptions& level )
+        {
+            const auto level_size = geode::internal::raster_level_size(
+                dataset(), read_coordinate_system(), level );
+            auto& band = raster_band( 0 );
+            const auto nb_overviews =
+                static_cast< geode::index_t >( band.GetOverviewCount() );
+            for( const auto overview : geode::Range{ nb_overviews } )
+            {
+                const auto* overview_band =
+                    band.GetOverview( static_cast< int >( overview ) );
+                if( static_cast< geode::index_t >( overview_band->GetXSize() )
+                        == level_size[0]
+                    && static_cast< geode::index_t >(
+                           overview_band->GetYSize() )
+                           == level_size[1] )
+                {
+                    return static_cast< int >( overview );
+                }
+            }
+            return std::nullopt;
         }
 
     private:
-        std::string_view filename_;
+        std::array< geode::index_t, 2 > raster_size()
+        {
+            return { static_cast< geode::index_t >(
+                         dataset().GetRasterXSize() ),
+                static_cast< geode::index_t >( dataset().GetRasterYSize() ) };
+        }
+
+        geode::LightRegularGrid2D empty_grid(
+            const RasterSampling& sampling ) const
+        {
+            const auto& coordinate_system = sampling.coordinate_system;
+            return geode::LightRegularGrid2D{ coordinate_system.origin(),
+                sampling.pixels_number,
+                { coordinate_system.direction( 0 ),
+                    coordinate_system.direction( 1 ) } };
+        }
+
+        // Window cells are coarsened by the ratio between the level and the
+        // raster numbers of pixels
+        std::array< geode::index_t, 2 > window_pixels_number(
+            const geode::internal::GridWindow< 2 >& window,
+            const std::array< geode::index_t, 2 >& cells_number,
+            const std::array< geode::index_t, 2 >& level_size ) const
+        {
+            std::array< geode::index_t, 2 > pixels_number;
+            for( const auto d : geode::LRange{ 2 } )
+            {
+                pixels_number[d] = std::max( geode::index_t{ 1 },
+                    static_cast< geode::index_t >(
+                        std::uint64_t{ window.nb_cells( d ) } * level_size[d]
+                        / cells_number[d] ) );
+            }
+            return pixels_number;
+        }
+
+        // Each window pixel covers stride pixels of the raster in each
+        // direction and takes the value of the middle one, as GDAL nearest
+        // neighbour downsampling does. Coarser levels are read from the
+        // matching GDAL overview, or resampled if there is none.
+        geode::RasterImage2D read_raster_window(
+            const RasterSampling& sampling )
+        {
+            const auto width = sampling.pixels_number[0];
+            const auto height = sampling.pixels_number[1];
+            const auto source = sampling.source_size();
+            const geode::local_index_t nb_color_bands =
+                nb_bands() >= 3 ? 3 : 1;
+            std::array< std::vector< GByte >, 3 > colors;
+            for( const auto band : geode::LRange{ nb_color_bands } )
+            {
+                colors[band].resize( std::size_t{ width } * height );
+                const auto status =
+                    dataset()
+                        .GetRasterBand( band + 1 )
+                        ->RasterIO( GF_Read, sampling.window.begin( 0 ),
+                            sampling.window.begin( 1 ), source[0], source[1],
+                            colors[band].data(), width, height, GDT_Byte, 0,
+                            0 );
+                geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                    status == CE_None, nullptr,
+                    geode::OpenGeodeException::TYPE::internal,
+                    "[GEOTIFFInput] Failed to read raster window" );
+            }
+            geode::RasterImage2D raster{ { width, height } };
+            for( const auto pixel : geode::Range{ raster.nb_cells() } )
+            {
+                const auto red = colors[0][pixel];
+                raster.set_color( pixel,
+                    nb_color_bands == 3
+                        ? geode::RGBColor{ red, colors[1][pixel],
+                              colors[2][pixel] }
+                        : geode::RGBColor{ red, red, red } );
+            }
+            return raster;
+        }
+
+        geode::CoordinateSystem2D window_coordinate_system(
+            const geode::CoordinateSystem2D& coordinate_system,
+            const geode::internal::GridWindow< 2 >& window,
+            const std::array< geode::index_t, 2 >& pixels_number ) const
+        {
+            const auto& u = coordinate_system.direction( 0 );
+            const auto& v = coordinate_system.direction( 1 );
+            return geode::internal::raster_level_coordinate_system(
+                geode::CoordinateSystem2D{ { u, v },
+                    coordinate_system.origin() + u * window.begin( 0 )
+                        + v * window.begin( 1 ) },
+                { window.nb_cells( 0 ) * window.stride(),
+                    window.nb_cells( 1 ) * window.stride() },
+                pixels_number );
+        }
+
+    private:
+        std::string filename_;
     };
 } // namespace
 
@@ -73,12 +382,15 @@ namespace geode
     {
         LightRegularGrid2D GEOTIFFInput::read()
         {
+            register_gdal_drivers();
+            const ScopedGDALConfiguration gdal_scope{ options_.gdal };
             GEOTIFFInputImpl geo_reader( filename() );
-            return geo_reader.read_file();
+            return geo_reader.read_file( options_ );
         }
 
         Percentage GEOTIFFInput::is_loadable() const
         {
+            register_gdal_drivers();
             const auto raster_percent =
                 is_raster_image_loadable< 2 >( filename() );
             if( raster_percent.value() != 1 )
@@ -95,8 +407,190 @@ namespace geode
 
         auto GEOTIFFInput::additional_files() const -> AdditionalFiles
         {
+            register_gdal_drivers();
             detail::GDALFile reader{ this->filename() };
             return reader.additional_files< AdditionalFiles >();
         }
+
+        class GEOTIFFBandReader::Impl
+        {
+        public:
+            Impl( std::string_view filename,
+                const GEOTIFFInputOptions& options )
+                : cache_scope_{ cache_configuration( options.gdal ) },
+                  thread_configuration_{ thread_configuration( options.gdal ) },
+                  file_{ open_file( filename, thread_configuration_ ) },
+                  sampling_( file_.sampling( options ) ),
+                  is_native_level_{ options.level.is_native() }
+            {
+                if( !is_native_level_ )
+                {
+                    const ScopedGDALConfiguration gdal_scope{
+                        thread_configuration_
+                    };
+                    overview_ = file_.level_overview( options.level );
+                }
+            }
+
+            index_t nb_bands() const
+            {
+                return file_.nb_bands();
+            }
+
+            double value( index_t band, index_t cell ) const
+            {
+                OPENGEODE_ASSERT( band < nb_bands(),
+                    "[GEOTIFFBandReader::value] Invalid band index" );
+                std::lock_guard< std::mutex > lock{ mutex_ };
+                const ScopedGDALConfiguration gdal_scope{
+                    thread_configuration_
+                };
+                auto& raster_band = level_band( band );
+                const auto pixel = level_pixel(
+                    raster_band, band, sampling_.raster_pixel( cell ) );
+                int block_width;
+                int block_height;
+                raster_band.GetBlockSize( &block_width, &block_height );
+                const auto block_x =
+                    pixel[0] / static_cast< index_t >( block_width );
+                const auto block_y =
+                    pixel[1] / static_cast< index_t >( block_height );
+                auto* block = raster_band.GetLockedBlockRef(
+                    static_cast< int >( block_x ),
+                    static_cast< int >( block_y ) );
+                OpenGeodeGeosciencesIOMeshException::check_exception(
+                    block != nullptr, nullptr, OpenGeodeException::TYPE::data,
+                    "[GEOTIFFBandReader] Failed to read block of band ",
+                    band );
+                const auto type = raster_band.GetRasterDataType();
+                const auto offset =
+                    ( std::size_t{ pixel[1] - block_y * block_height }
+                            * block_width
+                        + pixel[0] - block_x * block_width )
+                    * GDALGetDataTypeSizeBytes( type );
+                double result;
+                GDALCopyWords(
+                    static_cast< const GByte* >( block->GetDataRef() ) + offset,
+                    type, 0, &result, GDT_Float64, 0, 1 );
+                block->DropLock();
+                return result;
+            }
+
+            void materialize( index_t band, LightRegularGrid2D& grid ) const
+            {
+                std::lock_guard< std::mutex > lock{ mutex_ };
+                const ScopedGDALConfiguration gdal_scope{
+                    thread_configuration_
+                };
+                read_band_attribute( file_.raster_band( band ), sampling_,
+                    grid, attribute_name( band ) );
+            }
+
+        private:
+            // Values at a coarser level are read from the overview of the
+            // level size, as GDAL does when reading the whole band. Other
+            // levels are resampled by GDAL and only read by materialize.
+            GDALRasterBand& level_band( index_t band ) const
+            {
+                auto& raster_band = file_.raster_band( band );
+                if( is_native_level_ )
+                {
+                    return raster_band;
+                }
+                OpenGeodeGeosciencesIOMeshException::check_exception(
+                    overview_.has_value(), nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[GEOTIFFBandReader::value] No overview has the size of "
+                    "the requested level: read the band with materialize" );
+                return *raster_band.GetOverview( overview_.value() );
+            }
+
+            // Pixel of the level band covering the raster pixel
+            std::array< index_t, 2 > level_pixel( GDALRasterBand& level_band,
+                index_t band,
+                const std::array< index_t, 2 >& raster_pixel ) const
+            {
+                if( is_native_level_ )
+                {
+                    return raster_pixel;
+                }
+                auto& raster_band = file_.raster_band( band );
+                return { static_cast< index_t >(
+                             std::uint64_t{ raster_pixel[0] }
+                             * level_band.GetXSize()
+                             / raster_band.GetXSize() ),
+                    static_cast< index_t >( std::uint64_t{ raster_pixel[1] }
+                                            * level_band.GetYSize()
+                                            / raster_band.GetYSize() ) };
+            }
+
+            // The block cache is shared by the process: it is grown for the
+            // whole reader lifetime
+            static GDALConfiguration cache_configuration(
+                const GDALConfiguration& configuration )
+            {
+                GDALConfiguration cache;
+                cache.cache_max = configuration.cache_max;
+                return cache;
+            }
+
+            // Thread-local options are applied around each GDAL call, on
+            // the calling thread
+            static GDALConfiguration thread_configuration(
+                GDALConfiguration configuration )
+            {
+                configuration.cache_max.reset();
+                return configuration;
+            }
+
+            static GEOTIFFInputImpl open_file( std::string_view filename,
+                const GDALConfiguration& configuration )
+            {
+                register_gdal_drivers();
+                const ScopedGDALConfiguration gdal_scope{ configuration };
+                return GEOTIFFInputImpl{ filename };
+            }
+
+        private:
+            const ScopedGDALConfiguration cache_scope_;
+            const GDALConfiguration thread_configuration_;
+            mutable GEOTIFFInputImpl file_;
+            RasterSampling sampling_;
+            bool is_native_level_;
+            std::optional< int > overview_;
+            mutable std::mutex mutex_;
+        };
+
+        GEOTIFFBandReader::GEOTIFFBandReader(
+            std::string_view filename, const GEOTIFFInputOptions& options )
+            : impl_{ filename, options }
+        {
+        }
+
+        GEOTIFFBandReader::GEOTIFFBandReader(
+            GEOTIFFBandReader&& ) noexcept = default;
+
+        GEOTIFFBandReader::~GEOTIFFBandReader() = default;
+
+        std::string GEOTIFFBandReader::attribute_name( index_t band )
+        {
+            return absl::StrCat( "band_", band + 1 );
+        }
+
+        index_t GEOTIFFBandReader::nb_bands() const
+        {
+            return impl_->nb_bands();
+        }
+
+        double GEOTIFFBandReader::value( index_t band, index_t cell ) const
+        {
+            return impl_->value( band, cell );
+        }
+
+        void GEOTIFFBandReader::materialize(
+            index_t band, LightRegularGrid2D& grid ) const
+        {
+            impl_->materialize( band, grid );
+        }
     } // namespace internal
 } // namespace geode
\ No newline at end of file
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/geosciences_io/mesh/internal/geotiff_output.hpp>
+
+#include <async++.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <absl/strings/str_cat.h>
+
+#include <gdal_priv.h>
+
+#include <geode/basic/attribute_manager.hpp>
+#include <geode/basic/logger.hpp>
+
+#include <geode/geometry/coordinate_system.hpp>
+#include <geode/geometry/point.hpp>
+#include <geode/geometry/vector.hpp>
+
+#include <geode/mesh/core/light_regular_grid.hpp>
+
+#include <geode/geosciences_io/mesh/internal/gdal_configuration.hpp>
+
+namespace
+{
+    // One item of a grid attribute, written in its own band
+    struct Band
+    {
+        std::shared_ptr< geode::AttributeBase > attribute;
+        geode::local_index_t item;
+        GDALDataType type;
+        std::string name;
+    };
+
+    template < typename Type >
+    bool is_attribute_of_type( const geode::AttributeBase& attribute )
+    {
+        return dynamic_cast< const geode::ReadOnlyAttribute< Type >* >(
+                   &attribute )
+               != nullptr;
+    }
+
+    // Attributes storing one value of a GDAL band type keep it, others are
+    // written through their float generic values
+    GDALDataType band_type( const geode::AttributeBase& attribute )
+    {
+        if( attribute.nb_items() != 1 )
+        {
+            return GDT_Float32;
+        }
+        if( is_attribute_of_type< std::uint8_t >( attribute ) )
+        {
+            return GDT_Byte;
+        }
+        if( is_attribute_of_type< std::int16_t >( attribute ) )
+        {
+            return GDT_Int16;
+        }
+        if( is_attribute_of_type< std::uint16_t >( attribute ) )
+        {
+            return GDT_UInt16;
+        }
+        if( is_attribute_of_type< std::int32_t >( attribute ) )
+        {
+            return GDT_Int32;
+        }
+        if( is_attribute_of_type< std::uint32_t >( attribute ) )
+        {
+            return GDT_UInt32;
+        }
+        if( is_attribute_of_type< double >( attribute ) )
+        {
+            return GDT_Float64;
+        }
+        return GDT_Float32;
+    }
+
+    template < typename Type >
+    double typed_value(
+        const geode::AttributeBase& attribute, geode::index_t element )
+    {
+        return static_cast< double >(
+            static_cast< const geode::ReadOnlyAttribute< Type >& >( attribute )
+                .value( element ) );
+    }
+
+    double band_value( const Band& band, geode::index_t element )
+    {
+        const auto& attribute = *band.attribute;
+        switch( band.type )
+        {
+        case GDT_Byte:
+            return typed_value< std::uint8_t >( attribute, element );
+        case GDT_Int16:
+            return typed_value< std::int16_t >( attribute, element );
+        case GDT_UInt16:
+            return typed_value< std::uint16_t >( attribute, element );
+        case GDT_Int32:
+            return typed_value< std::int32_t >( attribute, element );
+        case GDT_UInt32:
+            return typed_value< std::uint32_t >( attribute, element );
+        case GDT_Float64:
+            return typed_value< double >( attribute, element );
+        default:
+            return attribute.generic_item_value( element, band.item );
+        }
+    }
+
+    class GEOTIFFOutputImpl
+    {
+    public:
+        GEOTIFFOutputImpl( std::string_view filename,
+            const geode::LightRegularGrid2D& grid,
+            const geode::internal::GEOTIFFOutputOptions& options )
+            : filename_( filename ), grid_( grid ), options_( options )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                options_.tile_size > 0 && options_.tile_size % 16 == 0,
+                nullptr, geode::OpenGeodeException::TYPE::data,
+                "[GEOTIFFOutput] Tile size should be a positive multiple of "
+                "16, got ",
+                options_.tile_size );
+            const auto nb_vertex_offset = options_.vertex_attributes ? 1 : 0;
+            width_ = grid_.nb_cells_in_direction( 0 ) + nb_vertex_offset;
+            height_ = grid_.nb_cells_in_direction( 1 ) + nb_vertex_offset;
+        }
+
+        void write_file()
+        {
+            geode::Logger::info( "[GEOTIFFOutput::write] Writing tiff file." );
+            find_bands();
+            create_dataset();
+            write_georeferencing();
+            for( const auto band : geode::Indices{ bands_ } )
+            {
+                write_band( band );
+            }
+            build_overviews();
+            close_dataset();
+        }
+
+    private:
+        void find_bands()
+        {
+            const auto& manager = options_.vertex_attributes
+                                      ? grid_.vertex_attribute_manager()
+                                      : grid_.cell_attribute_manager();
+            for( const auto& name : manager.attribute_names() )
+            {
+                auto attribute = manager.find_generic_attribute( name );
+                if( !attribute || !attribute->is_genericable() )
+                {
+                    continue;
+                }
+                const auto type = band_type( *attribute );
+                const auto nb_items = attribute->nb_items();
+                for( const auto item : geode::LRange{ nb_items } )
+                {
+                    bands_.push_back( { attribute, item, type,
+                        nb_items == 1 ? geode::to_string( name )
+                                      : absl::StrCat( name, "_", item ) } );
+                }
+            }
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                !bands_.empty(), nullptr, geode::OpenGeodeException::TYPE::data,
+                "[GEOTIFFOutput] No genericable attribute to write" );
+        }
+
+        // All bands of a GeoTIFF share the same type
+        GDALDataType dataset_type() const
+        {
+            const auto type = bands_.front().type;
+            for( const auto& band : bands_ )
+            {
+                if( band.type != type )
+                {
+                    return GDT_Float64;
+                }
+            }
+            return type;
+        }
+
+        // Compression runs in GDAL worker threads, as tiles get complete
+        void create_dataset()
+        {
+            auto* driver = GetGDALDriverManager()->GetDriverByName( "GTiff" );
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                driver != nullptr, nullptr,
+                geode::OpenGeodeException::TYPE::internal,
+                "[GEOTIFFOutput] GTiff driver not found" );
+            const auto tile_size = absl::StrCat( options_.tile_size );
+            char** creation_options{ nullptr };
+            creation_options =
+                CSLSetNameValue( creation_options, "TILED", "YES" );
+            creation_options = CSLSetNameValue(
+                creation_options, "BLOCKXSIZE", tile_size.c_str() );
+            creation_options = CSLSetNameValue(
+                creation_options, "BLOCKYSIZE", tile_size.c_str() );
+            creation_options = CSLSetNameValue(
+                creation_options, "COMPRESS", options_.compression.c_str() );
+            creation_options =
+                CSLSetNameValue( creation_options, "NUM_THREADS", "ALL_CPUS" );
+            creation_options =
+                CSLSetNameValue( creation_options, "BIGTIFF", "IF_SAFER" );
+            dataset_.reset( driver->Create(
+                geode::to_string( filename_ ).c_str(),
+                static_cast< int >( width_ ), static_cast< int >( height_ ),
+                static_cast< int >( bands_.size() ), dataset_type(),
+                creation_options ) );
+            CSLDestroy( creation_options );
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                dataset_ != nullptr, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[GEOTIFFOutput] Cannot create file ", filename_ );
+        }
+
+        // Pixels are centered on the vertices when writing vertex attributes
+        void write_georeferencing()
+        {
+            const auto& coordinate_system = grid_.grid_coordinate_system();
+            const auto& u = coordinate_system.direction( 0 );
+            const auto& v = coordinate_system.direction( 1 );
+            auto origin = coordinate_system.origin();
+            if( options_.vertex_attributes )
+            {
+                origin = origin + ( u + v ) * -0.5;
+            }
+            std::array< double, 6 > transform{ origin.value( 0 ), u.value( 0 ),
+                v.value( 0 ), origin.value( 1 ), u.value( 1 ), v.value( 1 ) };
+            dataset_->SetGeoTransform( transform.data() );
+        }
+
+        // Rows of tiles are filled in parallel, then written. GDAL flushes
+        // and compresses each tile once complete.
+        void write_band( geode::index_t band_id )
+        {
+            const auto& band = bands_[band_id];
+            auto* raster_band =
+                dataset_->GetRasterBand( static_cast< int >( band_id ) + 1 );
+            raster_band->SetDescription( band.name.c_str() );
+            if( options_.no_data_value )
+            {
+                raster_band->SetNoDataValue( options_.no_data_value.value() );
+            }
+            const auto tile_size = options_.tile_size;
+            std::vector< double > values(
+                std::size_t{ width_ } * std::min( tile_size, height_ ) );
+            for( geode::index_t first_row = 0; first_row < height_;
+                 first_row += tile_size )
+            {
+                const auto nb_rows = std::min( tile_size, height_ - first_row );
+                async::parallel_for(
+                    async::irange( geode::index_t{ 0 }, nb_rows ),
+                    [&]( geode::index_t row ) {
+                        const auto j = first_row + row;
+                        auto* row_values =
+                            values.data() + std::size_t{ row } * width_;
+                        for( const auto i : geode::Range{ width_ } )
+                        {
+                            row_values[i] = band_value( band, element( i, j ) );
+                        }
+                    } );
+                const auto status = raster_band->RasterIO( GF_Write, 0,
+                    static_cast< int >( first_row ),
+                    static_cast< int >( width_ ), static_cast< int >( nb_rows ),
+                    values.data(), static_cast< int >( width_ ),
+                    static_cast< int >( nb_rows ), GDT_Float64, 0, 0 );
+                geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                    status == CE_None, nullptr,
+                    geode::OpenGeodeException::TYPE::data,
+                    "[GEOTIFFOutput] Failed to write band ", band.name );
+            }
+        }
+
+        geode::index_t element( geode::index_t i, geode::index_t j ) const
+        {
+            if( options_.vertex_attributes )
+            {
+                return grid_.vertex_index( { i, j } );
+            }
+            return grid_.cell_index( { i, j } );
+        }
+
+        void build_overviews()
+        {
+            std::vector< int > factors;
+            for( const auto factor : options_.overviews )
+            {
+                if( factor > 1 && factor < std::max( width_, height_ ) )
+                {
+                    factors.push_back( static_cast< int >( factor ) );
+                }
+            }
+            if( factors.empty() )
+            {
+                return;
+            }
+            const auto status = dataset_->BuildOverviews(
+                options_.overview_resampling.c_str(),
+                static_cast< int >( factors.size() ), factors.data(), 0,
+                nullptr, nullptr, nullptr );
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                status == CE_None, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[GEOTIFFOutput] Failed to build overviews" );
+        }
+
+        // Pending tiles and overviews are compressed and written when the
+        // dataset is closed
+        void close_dataset()
+        {
+            CPLErrorReset();
+            dataset_.reset();
+            const auto error = CPLGetLastErrorType();
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                error != CE_Failure && error != CE_Fatal, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[GEOTIFFOutput] Failed to write file ", filename_, ": ",
+                CPLGetLastErrorMsg() );
+        }
+
+    private:
+        std::string_view filename_;
+        const geode::LightRegularGrid2D& grid_;
+        const geode::internal::GEOTIFFOutputOptions& options_;
+        geode::index_t width_;
+        geode::index_t height_;
+        std::vector< Band > bands_;
+        GDALDatasetUniquePtr dataset_;
+    };
+} // namespace
+
+namespace geode
+{
+    namespace internal
+    {
+        std::vector< std::string > GEOTIFFOutput::write(
+            const LightRegularGrid2D& grid ) const
+        {
+            register_gdal_drivers();
+            GEOTIFFOutputImpl impl{ filename(), grid, options_ };
+            impl.write_file();
+            return { to_string( filename() ) };
+        }
+    } // namespace internal
+} // namespace geode
@@ -23,349 +23,872 @@
 
 #include <geode/geosciences_io/mesh/internal/grdecl_input.hpp>
 
+#include <async++.h>
+
+#include <algorithm>
 #include <fstream>
 #include <optional>
+#include <streambuf>
 #include <string>
 
+#include <absl/algorithm/container.h>
+#include <absl/container/fixed_array.h>
+#include <absl/strings/ascii.h>
+#include <absl/strings/charconv.h>
 #include <absl/strings/match.h>
-#include <absl/strings/str_split.h>
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_cat.h>
+#include <absl/strings/strip.h>
+#include <absl/types/span.h>
 
 #include <geode/basic/attribute_manager.hpp>
 #include <geode/basic/file.hpp>
 #include <geode/basic/filename.hpp>
 #include <geode/basic/logger.hpp>
 #include <geode/basic/string.hpp>
+#include <geode/basic/variable_attribute.hpp>
 
-#include <geode/geometry/nn_search.hpp>
-
-#include <geode/mesh/builder/hybrid_solid_builder.hpp>
 #include <geode/mesh/core/hybrid_solid.hpp>
 
+#include <geode/geosciences_io/mesh/internal/corner_point_grid.hpp>
 #include <geode/geosciences_io/mesh/internal/gocad_common.hpp>
 
 namespace
 {
-    struct Pillar
-    {
-        geode::Point3D top;
-        geode::Point3D bottom;
+    // Size in bytes of the chunks of a ZCORN record parsed in parallel
+    static constexpr std::streamoff RECORD_CHUNK_SIZE{ 16 * 1024 * 1024 };
+
+    // Keywords read apart from the cell properties
+    static constexpr std::array< std::string_view, 5 > GRID_KEYWORDS{
+        "SPECGRID", "COORD", "ZCORN", "ACTNUM", "INCLUDE"
     };
 
-    geode::Point3D interpolate_on_pillar(
-        const double depth, const Pillar& pillar )
+    std::optional< std::string_view > record_keyword( std::string_view line )
     {
-        const auto lambda =
-            ( depth - pillar.top.value( 2 ) )
-            / ( pillar.bottom.value( 2 ) - pillar.top.value( 2 ) );
-        return pillar.bottom * lambda + pillar.top * ( 1 - lambda );
+        const auto first_token = absl::StripLeadingAsciiWhitespace( line );
+        if( first_token.empty() || !absl::ascii_isupper( first_token[0] ) )
+        {
+            return std::nullopt;
+        }
+        return first_token.substr(
+            0, first_token.find_first_of( " \t\r/" ) );
     }
 
-    class GRDECLInputImpl
+    void skip_record( std::ifstream& file, std::string_view keyword_line )
+    {
+        if( absl::StrContains( keyword_line, "/" ) )
+        {
+            return;
+        }
+        std::string line;
+        while( std::getline( file, line ) )
+        {
+            if( absl::StrContains( line, "/" ) )
+            {
+                return;
+            }
+        }
+    }
+
+    // Checks if the next meaningful line does not start a new keyword, i.e.
+    // if the current keyword has data. The stream position is unchanged.
+    bool has_record_data( std::ifstream& file )
     {
+        const auto position = file.tellg();
+        std::string line;
+        while( std::getline( file, line ) )
+        {
+            const auto content = absl::StripLeadingAsciiWhitespace( line );
+            if( content.empty() || geode::string_starts_with( content, "--" ) )
+            {
+                continue;
+            }
+            file.seekg( position );
+            return !record_keyword( content );
+        }
+        file.clear();
+        file.seekg( position );
+        return false;
+    }
+
+    // Reads the values of an Eclipse record up to its terminating slash,
+    // without going through intermediate strings. Values may span several
+    // lines, be followed by "--" comments and use repeat counts (N*value,
+    // or N* for N defaulted values).
+    class RecordReader
+    {
+        static constexpr std::size_t MAX_TOKEN_SIZE{ 64 };
+
+        struct RepeatedValue
+        {
+            geode::index_t repeat{ 1 };
+            std::optional< double > value;
+        };
+
     public:
-        GRDECLInputImpl(
-            std::string_view filename, geode::HybridSolid3D& solid )
-            : file_{ geode::to_string( filename ), std::ios::binary },
-              filepath_{
-                  geode::filepath_without_filename( filename ).string()
-              },
-              solid_( solid ),
-              builder_{ geode::HybridSolidBuilder< 3 >::create( solid_ ) }
+        explicit RecordReader( std::istream& stream )
+            : buffer_( *stream.rdbuf() )
         {
         }
 
-        void read_file()
+        explicit RecordReader( std::streambuf& buffer ) : buffer_( buffer ) {}
+
+        bool is_terminated() const
         {
-            read_dimensions();
-            get_filenames_and_keywords();
-            const auto pillars = keyword_to_filename_map_.contains( "COORD" )
-                                     ? read_pillars_with_file()
-                                     : read_pillars();
-            const auto depths = keyword_to_filename_map_.contains( "ZCORN" )
-                                    ? read_depths_with_file()
-                                    : read_depths();
-            create_cells( pillars, depths );
+            return is_terminated_;
         }
 
-    private:
-        void get_filenames_and_keywords()
+        // Calls set_value( value_id, value ) for each value of the record,
+        // defaulted values being skipped. Returns the number of values, or
+        // std::nullopt if the record is not made of at most max_nb_values
+        // numbers.
+        template < typename Setter >
+        std::optional< geode::index_t > read(
+            geode::index_t max_nb_values, Setter&& set_value )
         {
-            auto line = geode::goto_keyword_if_it_exists( file_, "INCLUDE" );
-            while( line != std::nullopt )
+            geode::index_t nb_values{ 0 };
+            bool is_valid{ true };
+            while( next_token() )
             {
-                std::getline( file_, line.value() );
-                const auto tokens = absl::StrSplit( line.value(), "_" );
-                for( const auto& token : tokens )
+                if( !is_valid )
                 {
-                    if( !absl::StrContains( token, "." ) )
-                    {
-                        continue;
-                    }
-                    const auto second_tokens = absl::StrSplit( token, "." );
-                    for( const auto& second_token : second_tokens )
+                    continue;
+                }
+                const auto repeated_value = parse_token();
+                if( !repeated_value
+                    || repeated_value->repeat > max_nb_values - nb_values )
+                {
+                    is_valid = false;
+                    continue;
+                }
+                if( repeated_value->value )
+                {
+                    for( const auto value_id : geode::Range{
+                             nb_values, nb_values + repeated_value->repeat } )
                     {
-                        auto string_without_spaces =
-                            geode::string_split( line.value() )[0];
-                        keyword_to_filename_map_[second_token] =
-                            std::string{ string_without_spaces.substr(
-                                1, string_without_spaces.size() - 2 ) };
-                        break;
+                        set_value( value_id, repeated_value->value.value() );
                     }
                 }
-
-                line = geode::goto_keyword_if_it_exists( file_, "INCLUDE" );
+                nb_values += repeated_value->repeat;
             }
+            if( !is_valid )
+            {
+                return std::nullopt;
+            }
+            return nb_values;
         }
 
-        void read_dimensions()
+    private:
+        // Returns false when the end of the record is reached
+        bool next_token()
         {
-            auto line = geode::goto_keyword( file_, "SPECGRID" );
-            while( !absl::StrContains( line, "F" ) )
+            token_size_ = 0;
+            for( auto character = buffer_.sgetc(); character != END_OF_FILE;
+                 character = buffer_.sgetc() )
             {
-                std::getline( file_, line );
+                buffer_.sbumpc();
+                if( character == '/' )
+                {
+                    is_terminated_ = true;
+                    return false;
+                }
+                if( character == '-' && buffer_.sgetc() == '-' )
+                {
+                    skip_line();
+                    continue;
+                }
+                if( is_space( character ) )
+                {
+                    continue;
+                }
+                add_to_token( character );
+                read_token_end();
+                return true;
             }
-            const auto tokens = geode::string_split( line );
-            nx_ = geode::string_to_index( tokens[0] );
-            ny_ = geode::string_to_index( tokens[1] );
-            nz_ = geode::string_to_index( tokens[2] );
+            return false;
         }
 
-        absl::FixedArray< Pillar > read_pillars_from_file(
-            std::ifstream& file ) const
+        void read_token_end()
         {
-            absl::FixedArray< Pillar > pillars( ( nx_ + 1 ) * ( ny_ + 1 ) );
-            auto line = geode::goto_keyword( file, "COORD" );
-            std::getline( file, line );
-            geode::index_t pillar_number{ 0 };
-            while( !geode::string_starts_with( line, "/" ) )
+            for( auto character = buffer_.sgetc();
+                 character != END_OF_FILE && character != '/'
+                 && !is_space( character );
+                 character = buffer_.snextc() )
             {
-                if( auto pillar = read_pillar( file, line ) )
+                if( character == '-' && token_[token_size_ - 1] == '-' )
                 {
-                    pillars[pillar_number++] = std::move( pillar.value() );
+                    token_size_--;
+                    skip_line();
+                    return;
                 }
-                std::getline( file, line );
+                add_to_token( character );
             }
-            return pillars;
         }
 
-        std::optional< Pillar > read_pillar(
-            std::ifstream& file, std::string_view line ) const
+        void add_to_token( int character )
         {
-            const auto tokens = geode::string_split( line );
-            if( tokens.empty() )
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                token_size_ < MAX_TOKEN_SIZE, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[GRDECLInput] Too long value found in record" );
+            token_[token_size_++] = static_cast< char >( character );
+        }
+
+        void skip_line()
+        {
+            for( auto character = buffer_.sgetc();
+                 character != END_OF_FILE && character != '\n';
+                 character = buffer_.snextc() )
+            {
+            }
+        }
+
+        std::optional< RepeatedValue > parse_token()
+        {
+            std::string_view token{ token_.data(), token_size_ };
+            RepeatedValue result;
+            const auto repeat_end = token.find( '*' );
+            if( repeat_end != std::string_view::npos )
+            {
+                if( !absl::SimpleAtoi(
+                        token.substr( 0, repeat_end ), &result.repeat ) )
+                {
+                    return std::nullopt;
+                }
+                token.remove_prefix( repeat_end + 1 );
+                if( token.empty() )
+                {
+                    return result;
+                }
+            }
+            // Fortran double precision exponent, e.g. 1.5D+03
+            const auto exponent = token.find_first_of( "dD" );
+            if( exponent != std::string_view::npos )
+            {
+                token_[token.data() - token_.data() + exponent] = 'E';
+            }
+            double value;
+            const auto token_end = token.data() + token.size();
+            const auto conversion =
+                absl::from_chars( token.data(), token_end, value );
+            if( conversion.ec != std::errc{} || conversion.ptr != token_end )
             {
                 return std::nullopt;
             }
-            std::optional< Pillar > pillar{ std::in_place };
-            if( tokens.size() == 6 )
+            result.value = value;
+            return result;
+        }
+
+        static bool is_space( int character )
+        {
+            return absl::ascii_isspace(
+                static_cast< unsigned char >( character ) );
+        }
+
+    private:
+        static constexpr auto END_OF_FILE = std::char_traits< char >::eof();
+        std::streambuf& buffer_;
+        std::array< char, MAX_TOKEN_SIZE > token_;
+        std::size_t token_size_{ 0 };
+        bool is_terminated_{ false };
+    };
+
+    // Text of a byte range of a file, exposed as a stream buffer
+    class FileChunk : public std::streambuf
+    {
+    public:
+        FileChunk( const std::string& filename,
+            std::streamoff begin,
+            std::streamoff end )
+            : text_( static_cast< std::size_t >( end - begin ), '\0' )
+        {
+            std::ifstream file{ filename, std::ios::binary };
+            file.seekg( begin );
+            file.read( text_.data(), end - begin );
+            setg( text_.data(), text_.data(), text_.data() + text_.size() );
+        }
+
+    private:
+        std::string text_;
+    };
+
+    // Record with data found while indexing a file. Its values start at the
+    // line following its keyword and end before the end offset.
+    struct RecordLocation
+    {
+        std::string keyword;
+        std::string filename;
+        std::streamoff begin;
+        std::streamoff end;
+    };
+
+    std::ifstream record_stream( const RecordLocation& record )
+    {
+        std::ifstream file{ record.filename, std::ios::binary };
+        file.seekg( record.begin );
+        return file;
+    }
+
+    // Splits the record in byte ranges starting at the beginning of a line
+    std::vector< std::streamoff > record_chunk_limits(
+        const RecordLocation& record )
+    {
+        auto file = record_stream( record );
+        std::vector< std::streamoff > limits{ record.begin };
+        std::string line;
+        while( limits.back() + RECORD_CHUNK_SIZE < record.end )
+        {
+            file.seekg( limits.back() + RECORD_CHUNK_SIZE );
+            if( !std::getline( file, line ) || file.tellg() < 0
+                || file.tellg() >= record.end )
+            {
+                break;
+            }
+            limits.push_back( file.tellg() );
+        }
+        limits.push_back( record.end );
+        return limits;
+    }
+
+    struct PropertyColumn
+    {
+        std::string name;
+        std::vector< double > values;
+    };
+
+    struct ActiveCells
+    {
+        std::vector< bool > is_active;
+        geode::index_t nb_active_cells{ 0 };
+        // Rank of each cell among the active cells, NO_ID for inactive
+        // cells. Only computed when the inactive cells are skipped.
+        std::vector< geode::index_t > ranks;
+    };
+
+    // Values of a record kept for the active cells only. Whether the record
+    // gives one value per cell or one value per active cell is only known
+    // once it is read: values are stored as given until one is found beyond
+    // the active cells, they are then moved to the rank of their cell.
+    class ActiveCellValues
+    {
+    public:
+        explicit ActiveCellValues( const ActiveCells& active_cells )
+            : ranks_( active_cells.ranks ),
+              values_( active_cells.nb_active_cells, 0 )
+        {
+        }
+
+        void set_value( geode::index_t value_id, double value )
+        {
+            if( !is_per_cell_ && value_id >= values_.size() )
+            {
+                move_to_ranks();
+            }
+            if( !is_per_cell_ )
+            {
+                values_[value_id] = value;
+                return;
+            }
+            if( const auto rank = ranks_[value_id]; rank != geode::NO_ID )
+            {
+                values_[rank] = value;
+            }
+        }
+
+        // Returns the values if the record has one value per cell or one
+        // value per active cell
+        std::optional< std::vector< double > > values(
+            geode::index_t nb_values )
+        {
+            if( nb_values == ranks_.size() )
+            {
+                move_to_ranks();
+                return std::move( values_ );
+            }
+            if( nb_values == values_.size() && !is_per_cell_ )
             {
-                for( const auto d : geode::LRange{ 3 } )
+                return std::move( values_ );
+            }
+            return std::nullopt;
+        }
+
+    private:
+        // Ranks are lower than cells, so moving values in the cell order
+        // never overwrites a value not moved yet
+        void move_to_ranks()
+        {
+            if( is_per_cell_ )
+            {
+                return;
+            }
+            is_per_cell_ = true;
+            geode::index_t nb_moved_values{ 0 };
+            for( const auto cell : geode::Range{
+                     static_cast< geode::index_t >( values_.size() ) } )
+            {
+                if( const auto rank = ranks_[cell]; rank != geode::NO_ID )
                 {
-                    pillar->top.set_value(
-                        d, geode::string_to_double( tokens[d] ) );
-                    pillar->bottom.set_value(
-                        d, geode::string_to_double( tokens[d + 3] ) );
+                    values_[rank] = values_[cell];
+                    nb_moved_values++;
                 }
             }
-            else if( tokens.size() == 3 )
+            std::fill(
+                values_.begin() + nb_moved_values, values_.end(), 0. );
+        }
+
+    private:
+        absl::Span< const geode::index_t > ranks_;
+        std::vector< double > values_;
+        bool is_per_cell_{ false };
+    };
+
+    class GRDECLInputImpl
+    {
+    public:
+        GRDECLInputImpl( std::string_view filename, bool skip_inactive_cells )
+            : filename_{ filename },
+              filepath_{
+                  geode::filepath_without_filename( filename ).string()
+              },
+              skip_inactive_cells_{ skip_inactive_cells }
+        {
+        }
+
+        // The file is indexed once, then each record is parsed from its
+        // offset by the task needing it
+        geode::internal::CornerPointGrid read_file()
+        {
+            index_records( geode::to_string( filename_ ) );
+            read_dimensions();
+            geode::internal::CornerPointGrid grid{ nx_, ny_, nz_ };
+            auto pillars_task = async::spawn( [this, &grid] {
+                read_pillars( grid.modifiable_pillar_coordinates() );
+            } );
+            auto depths_task = async::spawn( [this, &grid] {
+                read_depths( grid.modifiable_corner_depths() );
+            } );
+            auto cell_data_task = async::spawn( [this] {
+                auto active_cells = read_active_cells();
+                auto properties = read_properties( active_cells );
+                return std::make_pair(
+                    std::move( active_cells ), std::move( properties ) );
+            } );
+            pillars_task.wait();
+            depths_task.wait();
+            cell_data_task.wait();
+            pillars_task.get();
+            depths_task.get();
+            auto [active_cells, properties] = cell_data_task.get();
+            if( !active_cells )
             {
-                for( const auto d : geode::LRange{ 3 } )
+                for( auto& property : properties )
                 {
-                    pillar->top.set_value(
-                        d, geode::string_to_double( tokens[d] ) );
+                    grid.add_cell_property(
+                        property.name, std::move( property.values ) );
                 }
-                std::string second_line;
-                std::getline( file, second_line );
-                const auto second_tokens = geode::string_split( second_line );
-                for( const auto d : geode::LRange{ 3 } )
+                return grid;
+            }
+            grid.set_active_cells( std::move( active_cells->is_active ) );
+            if( skip_inactive_cells_ )
+            {
+                active_cell_properties_ = std::move( properties );
+                return grid;
+            }
+            for( auto& property : properties )
+            {
+                grid.add_cell_property(
+                    property.name, std::move( property.values ) );
+            }
+            return grid;
+        }
+
+        // Properties kept for the active cells only are set on the
+        // polyhedra of the solid built without the inactive cells, which are
+        // sorted as the active cells
+        void add_active_cell_properties( geode::HybridSolid3D& solid ) const
+        {
+            auto& attribute_manager = solid.polyhedron_attribute_manager();
+            for( const auto& property : active_cell_properties_ )
+            {
+                auto attribute = attribute_manager.find_or_create_attribute<
+                    geode::VariableAttribute, double >( property.name, 0 );
+                for( const auto polyhedron :
+                    geode::Range{ solid.nb_polyhedra() } )
                 {
-                    pillar->bottom.set_value(
-                        d, geode::string_to_double( second_tokens[d] ) );
+                    attribute->set_value(
+                        polyhedron, property.values[polyhedron] );
                 }
             }
-            else
+        }
+
+    private:
+        // Lists the records with data of the file and of its included files
+        // in reading order, skipping their values without parsing them.
+        void index_records( const std::string& filename )
+        {
+            std::ifstream file{ filename, std::ios::binary };
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                file.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+                "[GRDECLInput] Cannot open file ", filename );
+            file.seekg( 0, std::ios::end );
+            const std::streamoff file_end = file.tellg();
+            file.seekg( 0 );
+            std::string line;
+            while( std::getline( file, line ) )
             {
-                throw geode::OpenGeodeGeosciencesIOMeshException{ nullptr,
-                    geode::OpenGeodeException::TYPE::data,
-                    "[GRDECLInput::read_pillars] Wrong number of coordinates" };
+                const auto keyword = record_keyword( line );
+                if( !keyword || absl::StrContains( line, "/" )
+                    || !has_record_data( file ) )
+                {
+                    continue;
+                }
+                RecordLocation record{ geode::to_string( keyword.value() ),
+                    filename, file.tellg(), file_end };
+                if( record.keyword == "INCLUDE" )
+                {
+                    line = next_data_line( file );
+                    index_records(
+                        absl::StrCat( filepath_, included_filename( line ) ) );
+                    skip_record( file, line );
+                    continue;
+                }
+                skip_record( file, line );
+                if( file.good() )
+                {
+                    record.end = file.tellg();
+                }
+                records_.emplace_back( std::move( record ) );
+            }
+        }
+
+        static std::string next_data_line( std::ifstream& file )
+        {
+            std::string line;
+            while( std::getline( file, line ) )
+            {
+                const auto content = absl::StripLeadingAsciiWhitespace( line );
+                if( !content.empty()
+                    && !geode::string_starts_with( content, "--" ) )
+                {
+                    break;
+                }
             }
-            return pillar;
+            return line;
+        }
+
+        static std::string included_filename( std::string_view line )
+        {
+            const auto quoted_filename = geode::string_split( line )[0];
+            return geode::to_string(
+                quoted_filename.substr( 1, quoted_filename.size() - 2 ) );
+        }
+
+        const RecordLocation* find_record( std::string_view keyword ) const
+        {
+            const auto record = absl::c_find_if(
+                records_, [keyword]( const RecordLocation& location ) {
+                    return location.keyword == keyword;
+                } );
+            if( record == records_.end() )
+            {
+                return nullptr;
+            }
+            return &*record;
+        }
+
+        const RecordLocation& required_record( std::string_view keyword ) const
+        {
+            const auto* record = find_record( keyword );
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                record != nullptr, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[GRDECLInput] Missing ", keyword, " keyword" );
+            return *record;
         }
 
-        absl::FixedArray< Pillar > read_pillars()
+        void read_dimensions()
         {
-            return read_pillars_from_file( file_ );
+            auto file = record_stream( required_record( "SPECGRID" ) );
+            std::string line;
+            while( std::getline( file, line )
+                   && !absl::StrContains( line, "F" ) )
+            {
+            }
+            const auto tokens = geode::string_split( line );
+            nx_ = geode::string_to_index( tokens[0] );
+            ny_ = geode::string_to_index( tokens[1] );
+            nz_ = geode::string_to_index( tokens[2] );
         }
 
-        absl::FixedArray< Pillar > read_pillars_with_file()
+        void read_pillars( absl::Span< double > coordinates ) const
         {
-            std::ifstream file{ absl::StrCat(
-                filepath_, keyword_to_filename_map_["COORD"] ) };
-            return read_pillars_from_file( file );
+            auto file = record_stream( required_record( "COORD" ) );
+            const auto nb_coordinates = 6 * ( nx_ + 1 ) * ( ny_ + 1 );
+            const auto nb_values = RecordReader{ file }.read( nb_coordinates,
+                [&coordinates]( geode::index_t coordinate_id, double value ) {
+                    coordinates[coordinate_id] = value;
+                } );
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                nb_values == nb_coordinates, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[GRDECLInput::read_pillars] Wrong number of coordinates" );
         }
 
-        absl::FixedArray< double > read_depths_from_file(
-            std::ifstream& file ) const
+        // The ZCORN record is split in line-aligned chunks. Values are
+        // counted in each chunk in parallel to get the chunk offsets in the
+        // depth array, then parsed in parallel into it.
+        void read_depths( absl::Span< double > depths ) const
         {
-            absl::FixedArray< double > depths( 8 * nx_ * ny_ * nz_ );
-            auto line = geode::goto_keyword( file, "ZCORN" );
-            geode::index_t depths_number{ 0 };
-            std::getline( file, line );
-            while( !geode::string_starts_with( line, "/" ) )
+            const auto& record = required_record( "ZCORN" );
+            const auto chunk_limits = record_chunk_limits( record );
+            const auto nb_chunks =
+                static_cast< geode::index_t >( chunk_limits.size() - 1 );
+            absl::FixedArray< std::optional< geode::index_t > > nb_chunk_values(
+                nb_chunks );
+            absl::FixedArray< bool > is_chunk_terminated( nb_chunks, false );
+            async::parallel_for(
+                async::irange( geode::index_t{ 0 }, nb_chunks ),
+                [&]( geode::index_t chunk ) {
+                    FileChunk text{ record.filename, chunk_limits[chunk],
+                        chunk_limits[chunk + 1] };
+                    RecordReader reader{ text };
+                    nb_chunk_values[chunk] = reader.read( nb_depths(),
+                        []( geode::index_t /*depth_id*/, double /*value*/ ) {
+                        } );
+                    is_chunk_terminated[chunk] = reader.is_terminated();
+                } );
+            absl::FixedArray< geode::index_t > chunk_offsets( nb_chunks + 1 );
+            chunk_offsets[0] = 0;
+            auto nb_record_chunks = nb_chunks;
+            for( const auto chunk : geode::Range{ nb_chunks } )
             {
-                const auto tokens = geode::string_split( line );
-                for( const auto depths_id : geode::Indices{ tokens } )
+                geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                    nb_chunk_values[chunk].has_value(), nullptr,
+                    geode::OpenGeodeException::TYPE::data,
+                    "[GRDECLInput::read_depths] Wrong number of depths" );
+                chunk_offsets[chunk + 1] =
+                    chunk_offsets[chunk] + nb_chunk_values[chunk].value();
+                if( is_chunk_terminated[chunk] )
                 {
-                    depths[depths_number++] =
-                        geode::string_to_double( tokens[depths_id] );
+                    nb_record_chunks = chunk + 1;
+                    break;
                 }
-                std::getline( file, line );
-            }
-            return depths;
-        }
-
-        absl::FixedArray< double > read_depths()
-        {
-            return read_depths_from_file( file_ );
-        }
-
-        absl::FixedArray< double > read_depths_with_file()
-        {
-            std::ifstream file{ absl::StrCat(
-                filepath_, keyword_to_filename_map_["ZCORN"] ) };
-            return read_depths_from_file( file );
-        }
-
-        std::array< geode::Point3D, 8 > cell_points(
-            const std::array< geode::index_t, 3 >& grid_coordinates,
-            absl::Span< const Pillar > pillars,
-            absl::Span< const double > depths ) const
-        {
-            const auto pillars_id = cell_pillars_id( grid_coordinates );
-            const auto& bottom_left_pillar = pillars[pillars_id[0]];
-            const auto& top_left_pillar = pillars[pillars_id[1]];
-            const auto& bottom_right_pillar = pillars[pillars_id[2]];
-            const auto& top_right_pillar = pillars[pillars_id[3]];
-            std::array< geode::Point3D, 8 > points;
-            points[0] = interpolate_on_pillar(
-                depths[2 * grid_coordinates[0] + 4 * nx_ * grid_coordinates[1]
-                       + 4 * nx_ * ny_ * ( grid_coordinates[2] + 1 ) + 2 * nx_],
-                bottom_left_pillar );
-            points[1] = interpolate_on_pillar(
-                depths[2 * grid_coordinates[0] + 4 * nx_ * grid_coordinates[1]
-                       + 4 * nx_ * ny_ * ( grid_coordinates[2] + 1 ) + 2 * nx_
-                       + 1],
-                bottom_right_pillar );
-            points[2] = interpolate_on_pillar(
-                depths[2 * grid_coordinates[0] + 4 * nx_ * grid_coordinates[1]
-                       + 4 * nx_ * ny_ * ( grid_coordinates[2] + 1 ) + 1],
-                top_right_pillar );
-            points[3] = interpolate_on_pillar(
-                depths[2 * grid_coordinates[0] + 4 * nx_ * grid_coordinates[1]
-                       + 4 * nx_ * ny_ * ( grid_coordinates[2] + 1 )],
-                top_left_pillar );
-            points[4] = interpolate_on_pillar(
-                depths[2 * grid_coordinates[0] + 4 * nx_ * grid_coordinates[1]
-                       + 2 * nx_ + 4 * nx_ * ny_ * grid_coordinates[2]],
-                bottom_left_pillar );
-            points[5] = interpolate_on_pillar(
-                depths[2 * grid_coordinates[0] + 4 * nx_ * grid_coordinates[1]
-                       + 2 * nx_ + 1 + 4 * nx_ * ny_ * grid_coordinates[2]],
-                bottom_right_pillar );
-            points[6] = interpolate_on_pillar(
-                depths[2 * grid_coordinates[0] + 4 * nx_ * grid_coordinates[1]
-                       + 1 + 4 * nx_ * ny_ * grid_coordinates[2]],
-                top_right_pillar );
-            points[7] = interpolate_on_pillar(
-                depths[2 * grid_coordinates[0] + 4 * nx_ * grid_coordinates[1]
-                       + 4 * nx_ * ny_ * grid_coordinates[2]],
-                top_left_pillar );
-            return points;
-        }
-
-        geode::NNSearch3D::ColocatedInfo create_points(
-            absl::Span< const Pillar > pillars,
-            absl::Span< const double > depths )
-        {
-            std::vector< geode::Point3D > points;
-            points.reserve( 8 * nx_ * ny_ * nz_ );
-            for( const auto k : geode::Range{ nz_ } )
-            {
-                for( const auto j : geode::Range{ ny_ } )
+            }
+            check_nb_depths( chunk_offsets[nb_record_chunks] );
+            async::parallel_for(
+                async::irange( geode::index_t{ 0 }, nb_record_chunks ),
+                [&]( geode::index_t chunk ) {
+                    FileChunk text{ record.filename, chunk_limits[chunk],
+                        chunk_limits[chunk + 1] };
+                    const auto offset = chunk_offsets[chunk];
+                    RecordReader{ text }.read( nb_chunk_values[chunk].value(),
+                        [&depths, offset](
+                            geode::index_t depth_id, double value ) {
+                            depths[offset + depth_id] = value;
+                        } );
+                } );
+        }
+
+        geode::index_t nb_depths() const
+        {
+            return 8 * nx_ * ny_ * nz_;
+        }
+
+        void check_nb_depths( std::optional< geode::index_t > nb_values ) const
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                nb_values == nb_depths(), nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[GRDECLInput::read_depths] Wrong number of depths" );
+        }
+
+        std::optional< ActiveCells > read_active_cells() const
+        {
+            const auto* record = find_record( "ACTNUM" );
+            if( !record )
+            {
+                return std::nullopt;
+            }
+            auto file = record_stream( *record );
+            const auto nb_cells = nx_ * ny_ * nz_;
+            ActiveCells active_cells;
+            active_cells.is_active.resize( nb_cells, true );
+            const auto nb_values = RecordReader{ file }.read( nb_cells,
+                [&active_cells]( geode::index_t cell, double value ) {
+                    active_cells.is_active[cell] = value != 0;
+                } );
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                nb_values == nb_cells, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[GRDECLInput::read_active_cells] Wrong number of ACTNUM "
+                "values" );
+            active_cells.nb_active_cells = static_cast< geode::index_t >(
+                absl::c_count( active_cells.is_active, true ) );
+            if( skip_inactive_cells_ )
+            {
+                active_cells.ranks.resize( nb_cells, geode::NO_ID );
+                geode::index_t rank{ 0 };
+                for( const auto cell : geode::Range{ nb_cells } )
                 {
-                    for( const auto i : geode::Range{ nx_ } )
+                    if( active_cells.is_active[cell] )
                     {
-                        const std::array< geode::index_t, 3 > grid_coordinates{
-                            i, j, 2 * k
-                        };
-                        for( const auto point :
-                            cell_points( grid_coordinates, pillars, depths ) )
-                        {
-                            points.push_back( point );
-                        }
+                        active_cells.ranks[cell] = rank++;
                     }
                 }
             }
-            const auto collocated_mapping =
-                geode::NNSearch3D{ points }.colocated_index_mapping(
-                    geode::GLOBAL_EPSILON );
-            for( const auto& point : collocated_mapping.unique_points )
+            return active_cells;
+        }
+
+        // A record is a cell property when it is made of one number per
+        // cell, or of one number per active cell. Other records (FAULTS,
+        // EQUALS, BOX, MINPV...) are skipped with a warning. Property
+        // records are parsed concurrently.
+        std::vector< PropertyColumn > read_properties(
+            const std::optional< ActiveCells >& active_cells ) const
+        {
+            std::vector< const RecordLocation* > property_records;
+            for( const auto& record : records_ )
             {
-                builder_->create_point( point );
+                if( !absl::c_linear_search( GRID_KEYWORDS, record.keyword ) )
+                {
+                    property_records.push_back( &record );
+                }
             }
-            return collocated_mapping;
+            std::vector< std::optional< PropertyColumn > > record_properties(
+                property_records.size() );
+            async::parallel_for( async::irange( std::size_t{ 0 },
+                                     property_records.size() ),
+                [this, &property_records, &record_properties, &active_cells](
+                    std::size_t r ) {
+                    record_properties[r] =
+                        read_property( *property_records[r], active_cells );
+                } );
+            std::vector< PropertyColumn > properties;
+            for( auto& property : record_properties )
+            {
+                if( property )
+                {
+                    properties.emplace_back( std::move( property.value() ) );
+                }
+            }
+            return properties;
+        }
+
+        std::optional< PropertyColumn > read_property(
+            const RecordLocation& record,
+            const std::optional< ActiveCells >& active_cells ) const
+        {
+            if( active_cells && skip_inactive_cells_ )
+            {
+                return read_active_cell_property(
+                    record, active_cells.value() );
+            }
+            const auto nb_cells = nx_ * ny_ * nz_;
+            PropertyColumn property{ record.keyword,
+                std::vector< double >( nb_cells, 0 ) };
+            auto file = record_stream( record );
+            const auto nb_values = RecordReader{ file }.read( nb_cells,
+                [&property]( geode::index_t cell, double value ) {
+                    property.values[cell] = value;
+                } );
+            if( !nb_values )
+            {
+                warn_not_numbers( record.keyword );
+                return std::nullopt;
+            }
+            if( nb_values == nb_cells )
+            {
+                return property;
+            }
+            if( !active_cells )
+            {
+                geode::Logger::warn( "[GRDECLInput] Skipping ", record.keyword,
+                    " record: ", nb_values.value(), " values read, ",
+                    nb_cells, " cell values expected" );
+                return std::nullopt;
+            }
+            if( nb_values == active_cells->nb_active_cells )
+            {
+                spread_on_active_cells(
+                    property.values, active_cells->is_active );
+                return property;
+            }
+            warn_wrong_nb_values(
+                record.keyword, nb_values.value(), active_cells.value() );
+            return std::nullopt;
         }
 
-        void create_cells( absl::Span< const Pillar > pillars,
-            absl::Span< const double > depths )
+        // Only the values of the active cells are stored when the inactive
+        // cells are skipped
+        std::optional< PropertyColumn > read_active_cell_property(
+            const RecordLocation& record,
+            const ActiveCells& active_cells ) const
         {
-            const auto collocated_mapping = create_points( pillars, depths );
-            for( const auto cell_id : geode::Range{ nx_ * ny_ * nz_ } )
+            const auto nb_cells = nx_ * ny_ * nz_;
+            ActiveCellValues values{ active_cells };
+            auto file = record_stream( record );
+            const auto nb_values = RecordReader{ file }.read( nb_cells,
+                [&values]( geode::index_t value_id, double value ) {
+                    values.set_value( value_id, value );
+                } );
+            if( !nb_values )
+            {
+                warn_not_numbers( record.keyword );
+                return std::nullopt;
+            }
+            if( auto active_values = values.values( nb_values.value() ) )
             {
-                builder_->create_hexahedron(
-                    { collocated_mapping.colocated_mapping[0 + 8 * cell_id],
-                        collocated_mapping.colocated_mapping[1 + 8 * cell_id],
-                        collocated_mapping.colocated_mapping[2 + 8 * cell_id],
-                        collocated_mapping.colocated_mapping[3 + 8 * cell_id],
-                        collocated_mapping.colocated_mapping[4 + 8 * cell_id],
-                        collocated_mapping.colocated_mapping[5 + 8 * cell_id],
-                        collocated_mapping.colocated_mapping[6 + 8 * cell_id],
-                        collocated_mapping
-                            .colocated_mapping[7 + 8 * cell_id] } );
+                return PropertyColumn{ record.keyword,
+                    std::move( active_values.value() ) };
             }
-            builder_->compute_polyhedron_adjacencies();
+            warn_wrong_nb_values(
+                record.keyword, nb_values.value(), active_cells );
+            return std::nullopt;
         }
 
-        std::array< geode::index_t, 4 > cell_pillars_id(
-            const std::array< geode::index_t, 3 >& grid_coordinates ) const
+        void warn_not_numbers( std::string_view keyword ) const
         {
-            const auto number_of_vertices_on_lines = nx_ + 1;
-            const auto bottom_left_pillar_id =
-                grid_coordinates[0]
-                + number_of_vertices_on_lines * ( grid_coordinates[1] + 1 );
-            const auto top_left_pillar_id =
-                grid_coordinates[0]
-                + number_of_vertices_on_lines * grid_coordinates[1];
-            const auto bottom_right_pillar_id =
-                grid_coordinates[0]
-                + number_of_vertices_on_lines * ( grid_coordinates[1] + 1 ) + 1;
-            const auto top_right_pillar_id =
-                grid_coordinates[0]
-                + number_of_vertices_on_lines * grid_coordinates[1] + 1;
-            return { bottom_left_pillar_id, top_left_pillar_id,
-                bottom_right_pillar_id, top_right_pillar_id };
+            geode::Logger::warn( "[GRDECLInput] Skipping ", keyword,
+                " record: not a list of at most ", nx_ * ny_ * nz_,
+                " numbers" );
+        }
+
+        void warn_wrong_nb_values( std::string_view keyword,
+            geode::index_t nb_values,
+            const ActiveCells& active_cells ) const
+        {
+            geode::Logger::warn( "[GRDECLInput] Skipping ", keyword,
+                " record: ", nb_values, " values read, ", nx_ * ny_ * nz_,
+                " cell values or ", active_cells.nb_active_cells,
+                " active cell values expected" );
+        }
+
+        // Moves the values given for the active cells only to their cells,
+        // inactive cells getting 0. Values are moved from the last cell so
+        // that none is overwritten before being moved.
+        static void spread_on_active_cells( std::vector< double >& values,
+            const std::vector< bool >& is_active )
+        {
+            const auto nb_cells =
+                static_cast< geode::index_t >( values.size() );
+            auto active_cell = static_cast< geode::index_t >(
+                absl::c_count( is_active, true ) );
+            for( const auto c : geode::Range{ nb_cells } )
+            {
+                const auto cell = nb_cells - 1 - c;
+                values[cell] = is_active[cell] ? values[--active_cell] : 0;
+            }
         }
 
     private:
-        std::ifstream file_;
+        std::string_view filename_;
         std::string filepath_;
-        geode::HybridSolid3D& solid_;
-        std::unique_ptr< geode::HybridSolidBuilder3D > builder_{ nullptr };
+        bool skip_inactive_cells_;
         geode::index_t nx_{ geode::NO_ID };
         geode::index_t ny_{ geode::NO_ID };
         geode::index_t nz_{ geode::NO_ID };
-        absl::flat_hash_map< std::string, std::string >
-            keyword_to_filename_map_{};
+        std::vector< RecordLocation > records_;
+        std::vector< PropertyColumn > active_cell_properties_;
     };
 } // namespace
 
@@ -376,12 +899,20 @@ namespace geode
         std::unique_ptr< HybridSolid3D > GRDECLInput::read(
             const MeshImpl& impl )
         {
-            auto solid = HybridSolid3D::create( impl );
-            GRDECLInputImpl reader{ this->filename(), *solid };
-            reader.read_file();
+            GRDECLInputImpl reader{ this->filename(),
+                options_.skip_inactive_cells };
+            auto solid = reader.read_file().hybrid_solid(
+                impl, options_.skip_inactive_cells );
+            reader.add_active_cell_properties( *solid );
             return solid;
         }
 
+        CornerPointGrid GRDECLInput::read_corner_point_grid() const
+        {
+            GRDECLInputImpl reader{ this->filename(), false };
+            return reader.read_file();
+        }
+
         Percentage GRDECLInput::is_loadable() const
         {
             std::ifstream file{ to_string( this->filename() ) };
@@ -392,4 +923,4 @@ namespace geode
             return Percentage{ 0 };
         }
     } // namespace internal
-} // namespace geode
\ No newline at end of file
+} // namespace geode
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/geosciences_io/mesh/internal/grdecl_output.hpp>
+
+#include <async++.h>
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <absl/algorithm/container.h>
+#include <absl/container/flat_hash_set.h>
+#include <absl/strings/ascii.h>
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_format.h>
+
+#include <geode/basic/filename.hpp>
+#include <geode/basic/logger.hpp>
+
+#include <geode/mesh/core/hybrid_solid.hpp>
+#include <geode/mesh/core/regular_grid_solid.hpp>
+
+namespace
+{
+    // Number of values formatted by each task
+    static constexpr std::size_t FORMAT_CHUNK_SIZE{ 65536 };
+    // Number of chunks formatted before being written
+    static constexpr std::size_t NB_CHUNKS_PER_BATCH{ 64 };
+    // Keeps lines below the 132 characters read by simulators
+    static constexpr geode::index_t VALUES_PER_LINE{ 4 };
+    static constexpr char EOL{ '\n' };
+    // Keywords are at most 8 characters long for simulators
+    static constexpr std::size_t MAX_KEYWORD_SIZE{ 8 };
+    static constexpr std::array< std::string_view, 5 > GRID_KEYWORDS{
+        "SPECGRID", "COORD", "ZCORN", "ACTNUM", "INCLUDE"
+    };
+
+    // Writes 15 significant digits if it reads back to the same value,
+    // 17 otherwise
+    void append_value( std::string& text, double value )
+    {
+        std::array< char, 32 > buffer;
+        auto size =
+            absl::SNPrintF( buffer.data(), buffer.size(), "%.15g", value );
+        double read_value;
+        if( !absl::SimpleAtod(
+                std::string_view{ buffer.data(),
+                    static_cast< std::size_t >( size ) },
+                &read_value )
+            || read_value != value )
+        {
+            size =
+                absl::SNPrintF( buffer.data(), buffer.size(), "%.17g", value );
+        }
+        text.append( buffer.data(), size );
+    }
+
+    // Runs of equal values are written as N*value
+    std::string format_values( absl::Span< const double > values )
+    {
+        std::string text;
+        geode::index_t nb_tokens{ 0 };
+        for( std::size_t first = 0; first < values.size(); )
+        {
+            auto last = first + 1;
+            while( last < values.size() && values[last] == values[first] )
+            {
+                last++;
+            }
+            if( last - first > 1 )
+            {
+                absl::StrAppend( &text, last - first, "*" );
+            }
+            append_value( text, values[first] );
+            text.push_back( ++nb_tokens % VALUES_PER_LINE == 0 ? EOL : ' ' );
+            first = last;
+        }
+        if( !text.empty() )
+        {
+            text.back() = EOL;
+        }
+        return text;
+    }
+
+    void write_record( std::ofstream& file,
+        std::string_view keyword,
+        absl::Span< const double > values )
+    {
+        file << keyword << EOL;
+        const auto nb_chunks =
+            ( values.size() + FORMAT_CHUNK_SIZE - 1 ) / FORMAT_CHUNK_SIZE;
+        std::vector< std::string > texts(
+            std::min( NB_CHUNKS_PER_BATCH, nb_chunks ) );
+        for( std::size_t first_chunk = 0; first_chunk < nb_chunks;
+             first_chunk += NB_CHUNKS_PER_BATCH )
+        {
+            const auto nb_batch_chunks =
+                std::min( NB_CHUNKS_PER_BATCH, nb_chunks - first_chunk );
+            async::parallel_for(
+                async::irange( std::size_t{ 0 }, nb_batch_chunks ),
+                [&values, &texts, first_chunk]( std::size_t chunk ) {
+                    texts[chunk] = format_values( values.subspan(
+                        ( first_chunk + chunk ) * FORMAT_CHUNK_SIZE,
+                        FORMAT_CHUNK_SIZE ) );
+                } );
+            for( const auto chunk : geode::Range{ nb_batch_chunks } )
+            {
+                file << texts[chunk];
+            }
+        }
+        file << "/" << EOL << EOL;
+    }
+
+    class GRDECLOutputImpl
+    {
+    public:
+        GRDECLOutputImpl( const geode::internal::CornerPointGrid& grid,
+            std::string_view filename,
+            const geode::internal::GRDECLOutputOptions& options )
+            : grid_( grid ),
+              filename_{ geode::to_string( filename ) },
+              options_( options ),
+              file_{ filename_ },
+              files_{ filename_ }
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                file_.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+                "Error while opening file: ", filename );
+        }
+
+        std::vector< std::string > write_file()
+        {
+            write_dimensions();
+            write_keyword( "COORD", grid_.pillar_coordinates() );
+            write_keyword( "ZCORN", grid_.corner_depths() );
+            if( grid_.defines_active_cells() )
+            {
+                write_keyword( "ACTNUM", active_cells() );
+            }
+            for( const auto name : property_names() )
+            {
+                write_keyword(
+                    property_keyword( name ), grid_.cell_property( name ) );
+            }
+            return std::move( files_ );
+        }
+
+    private:
+        void write_dimensions()
+        {
+            file_ << "SPECGRID" << EOL << grid_.nb_cells_in_direction( 0 )
+                  << " " << grid_.nb_cells_in_direction( 1 ) << " "
+                  << grid_.nb_cells_in_direction( 2 ) << " 1 F" << EOL << "/"
+                  << EOL << EOL;
+        }
+
+        void write_keyword(
+            std::string_view keyword, absl::Span< const double > values )
+        {
+            if( !options_.use_include_files )
+            {
+                write_record( file_, keyword, values );
+                return;
+            }
+            const auto suffix = absl::StrCat( "_", keyword, ".inc" );
+            const auto include_file = absl::StrCat(
+                geode::filepath_without_extension( filename_ ).string(),
+                suffix );
+            std::ofstream file{ include_file };
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                file.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+                "Error while opening file: ", include_file );
+            write_record( file, keyword, values );
+            file_ << "INCLUDE" << EOL << "'"
+                  << geode::filename_without_extension( filename_ ).string()
+                  << suffix << "' /" << EOL << EOL;
+            files_.push_back( include_file );
+        }
+
+        std::vector< double > active_cells() const
+        {
+            std::vector< double > values( grid_.nb_cells() );
+            for( const auto cell : geode::Range{ grid_.nb_cells() } )
+            {
+                values[cell] = grid_.is_cell_active( cell ) ? 1 : 0;
+            }
+            return values;
+        }
+
+        // Keywords are upper case letters, digits and underscores starting
+        // with a letter. Other property names are renamed with a warning.
+        std::string property_keyword( std::string_view name )
+        {
+            auto keyword = absl::AsciiStrToUpper( name );
+            for( auto& character : keyword )
+            {
+                if( !absl::ascii_isalnum(
+                        static_cast< unsigned char >( character ) ) )
+                {
+                    character = '_';
+                }
+            }
+            if( keyword.empty()
+                || !absl::ascii_isalpha(
+                    static_cast< unsigned char >( keyword[0] ) ) )
+            {
+                keyword.insert( 0, "P" );
+            }
+            keyword.resize( std::min( keyword.size(), MAX_KEYWORD_SIZE ) );
+            const auto base = keyword;
+            for( geode::index_t copy = 1;
+                 keywords_.contains( keyword )
+                 || absl::c_linear_search( GRID_KEYWORDS, keyword );
+                 copy++ )
+            {
+                const auto suffix = absl::StrCat( copy );
+                keyword = absl::StrCat(
+                    base.substr( 0, MAX_KEYWORD_SIZE - suffix.size() ),
+                    suffix );
+            }
+            keywords_.insert( keyword );
+            if( keyword != name )
+            {
+                geode::Logger::warn( "[GRDECLOutput] Property ", name,
+                    " written as ", keyword, " keyword" );
+            }
+            return keyword;
+        }
+
+        std::vector< std::string_view > property_names() const
+        {
+            if( options_.properties.empty() )
+            {
+                return grid_.cell_property_names();
+            }
+            return { options_.properties.begin(), options_.properties.end() };
+        }
+
+    private:
+        const geode::internal::CornerPointGrid& grid_;
+        std::string filename_;
+        const geode::internal::GRDECLOutputOptions& options_;
+        std::ofstream file_;
+        std::vector< std::string > files_;
+        absl::flat_hash_set< std::string > keywords_;
+    };
+} // namespace
+
+namespace geode
+{
+    namespace internal
+    {
+        std::vector< std::string > write_grdecl( const CornerPointGrid& grid,
+            std::string_view filename,
+            const GRDECLOutputOptions& options )
+        {
+            GRDECLOutputImpl impl{ grid, filename, options };
+            return impl.write_file();
+        }
+
+        std::vector< std::string > GRDECLOutput::write(
+            const HybridSolid3D& solid ) const
+        {
+            return write_grdecl( corner_point_grid_from_hybrid_solid( solid ),
+                filename(), options_ );
+        }
+
+        std::vector< std::string > RegularGridGRDECLOutput::write(
+            const RegularGrid3D& grid ) const
+        {
+            return write_grdecl( corner_point_grid_from_regular_grid( grid ),
+                filename(), options_ );
+        }
+    } // namespace internal
+} // namespace geode
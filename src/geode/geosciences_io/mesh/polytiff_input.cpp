@@ -23,73 +23,159 @@
 
 #include <geode/geosciences_io/mesh/internal/polytiff_input.hpp>
 
-#include <gdal_priv.h>
+#include <algorithm>
+#include <vector>
 
-#include <geode/basic/filename.hpp>
-#include <geode/basic/logger.hpp>
+#include <gdal_priv.h>
 
+#include <geode/geometry/coordinate_system.hpp>
 #include <geode/geometry/point.hpp>
+#include <geode/geometry/vector.hpp>
 
 #include <geode/mesh/builder/polygonal_surface_builder.hpp>
-#include <geode/mesh/core/light_regular_grid.hpp>
 #include <geode/mesh/core/polygonal_surface.hpp>
-#include <geode/mesh/helpers/convert_surface_mesh.hpp>
 #include <geode/mesh/io/light_regular_grid_input.hpp>
 
 #include <geode/io/image/detail/gdal_file.hpp>
 
+#include <geode/geosciences_io/mesh/internal/raster_level.hpp>
+
 namespace
 {
+    // Builds the surface of the raster pixels: each pixel is a quad whose
+    // first corner takes the pixel elevation, corners of the last row and
+    // column taking the elevation of their closest pixel. Corners without
+    // data keep the no data value as elevation.
     class PolyTIFFInputImpl : public geode::detail::GDALFile
     {
     public:
-        PolyTIFFInputImpl( std::string_view filename )
-            : geode::detail::GDALFile{ filename }, filename_{ filename }
+        PolyTIFFInputImpl( geode::PolygonalSurface3D& surface,
+            std::string_view filename )
+            : geode::detail::GDALFile{ filename },
+              builder_{ geode::PolygonalSurfaceBuilder3D::create( surface ) }
         {
         }
 
-        std::unique_ptr< geode::PolygonalSurface3D > read_file()
+        void read_file( const geode::internal::RasterLevelOptions& level )
+        {
+            read_metadata( level );
+            const auto elevation = read_elevation();
+            create_vertices( elevation );
+            create_polygons();
+        }
+
+    private:
+        void read_metadata( const geode::internal::RasterLevelOptions& level )
         {
-            const auto level = geode::Logger::level();
-            geode::Logger::set_level( geode::Logger::LEVEL::critical );
-            const auto grid = geode::load_light_regular_grid< 2 >( filename_ );
-            geode::Logger::set_level( level );
-            auto surface2d = geode::convert_grid_into_polygonal_surface( grid );
             const auto nb_bands = dataset().GetRasterCount();
             geode::OpenGeodeGeosciencesIOMeshException::check_exception(
                 nb_bands > 0, nullptr, geode::OpenGeodeException::TYPE::data,
                 "[PolyTIFFInput] No bands found" );
-            absl::FixedArray< float > elevation( surface2d->nb_vertices() );
+            raster_width_ = dataset().GetRasterXSize();
+            raster_height_ = dataset().GetRasterYSize();
+            const auto raster_coordinate_system = read_coordinate_system();
+            const auto level_size = geode::internal::raster_level_size(
+                dataset(), raster_coordinate_system, level );
+            width_ = level_size[0];
+            height_ = level_size[1];
+            coordinate_system_ =
+                geode::internal::raster_level_coordinate_system(
+                    raster_coordinate_system, { raster_width_, raster_height_ },
+                    level_size );
+        }
+
+        std::vector< float > read_elevation()
+        {
+            std::vector< float > elevation(
+                static_cast< std::size_t >( width_ ) * height_ );
             const auto band = dataset().GetRasterBand( 1 );
-            const auto width = dataset().GetRasterXSize();
-            const auto height = dataset().GetRasterYSize();
-            const auto status = band->RasterIO( GF_Read, 0, 0, width, height,
-                elevation.data(), width, height, GDT_Float32, 0, 0 );
+            const auto status = band->RasterIO( GF_Read, 0, 0, raster_width_,
+                raster_height_, elevation.data(), width_, height_, GDT_Float32,
+                0, 0 );
             geode::OpenGeodeGeosciencesIOMeshException::check_exception(
                 status == CE_None, nullptr,
                 geode::OpenGeodeException::TYPE::internal,
                 "[PolyTIFFInput] Failed to read elevation" );
-            const auto no_data_value = band->GetNoDataValue();
-            auto surface3d = geode::convert_polygonal_surface2d_into_3d(
-                *surface2d, 2, no_data_value );
-            auto builder =
-                geode::PolygonalSurfaceBuilder3D::create( *surface3d );
-            for( const auto vertex : geode::Range{ surface3d->nb_vertices() } )
+            return elevation;
+        }
+
+        geode::index_t vertex_index( geode::index_t i, geode::index_t j ) const
+        {
+            return i + j * ( width_ + 1 );
+        }
+
+        // Points and adjacencies are set sequentially: the builder is not
+        // thread-safe
+        void create_vertices( absl::Span< const float > elevation )
+        {
+            builder_->create_vertices( vertex_index( 0, height_ + 1 ) );
+            for( const auto j : geode::Range{ height_ + 1 } )
+            {
+                const auto pixel_row = std::min( j, height_ - 1 ) * width_;
+                const auto j_contribution =
+                    coordinate_system_.direction( 1 ) * j;
+                for( const auto i : geode::Range{ width_ + 1 } )
+                {
+                    const auto point = coordinate_system_.origin()
+                                       + j_contribution
+                                       + coordinate_system_.direction( 0 ) * i;
+                    builder_->set_point( vertex_index( i, j ),
+                        geode::Point3D{ { point.value( 0 ), point.value( 1 ),
+                            elevation[pixel_row
+                                      + std::min( i, width_ - 1 )] } } );
+                }
+            }
+        }
+
+        // Polygons are the raster pixels, row after row. Their adjacencies
+        // follow the raster structure.
+        void create_polygons()
+        {
+            for( const auto j : geode::Range{ height_ } )
+            {
+                for( const auto i : geode::Range{ width_ } )
+                {
+                    builder_->create_polygon( { vertex_index( i, j ),
+                        vertex_index( i + 1, j ), vertex_index( i + 1, j + 1 ),
+                        vertex_index( i, j + 1 ) } );
+                }
+            }
+            for( const auto j : geode::Range{ height_ } )
             {
-                const auto current_elevation = elevation[vertex];
-                if( current_elevation == no_data_value )
+                for( const auto i : geode::Range{ width_ } )
                 {
-                    continue;
+                    const auto polygon = i + j * width_;
+                    if( j > 0 )
+                    {
+                        builder_->set_polygon_adjacent(
+                            { polygon, 0 }, polygon - width_ );
+                    }
+                    if( i + 1 < width_ )
+                    {
+                        builder_->set_polygon_adjacent(
+                            { polygon, 1 }, polygon + 1 );
+                    }
+                    if( j + 1 < height_ )
+                    {
+                        builder_->set_polygon_adjacent(
+                            { polygon, 2 }, polygon + width_ );
+                    }
+                    if( i > 0 )
+                    {
+                        builder_->set_polygon_adjacent(
+                            { polygon, 3 }, polygon - 1 );
+                    }
                 }
-                auto point = surface3d->point( vertex );
-                point.set_value( 2, current_elevation );
-                builder->set_point( vertex, point );
             }
-            return surface3d;
         }
 
     private:
-        std::string_view filename_;
+        std::unique_ptr< geode::PolygonalSurfaceBuilder3D > builder_;
+        geode::CoordinateSystem2D coordinate_system_;
+        geode::index_t width_{ 0 };
+        geode::index_t height_{ 0 };
+        geode::index_t raster_width_{ 0 };
+        geode::index_t raster_height_{ 0 };
     };
 } // namespace
 
@@ -98,14 +184,19 @@ namespace geode
     namespace internal
     {
         std::unique_ptr< PolygonalSurface3D > PolyTIFFInput::read(
-            const MeshImpl& /*impl*/ )
+            const MeshImpl& impl )
         {
-            PolyTIFFInputImpl geo_reader( filename() );
-            return geo_reader.read_file();
+            auto surface = PolygonalSurface3D::create( impl );
+            register_gdal_drivers();
+            const ScopedGDALConfiguration gdal_scope{ options_.gdal };
+            PolyTIFFInputImpl geo_reader{ *surface, filename() };
+            geo_reader.read_file( options_.level );
+            return surface;
         }
 
         auto PolyTIFFInput::additional_files() const -> AdditionalFiles
         {
+            register_gdal_drivers();
             detail::GDALFile reader{ filename() };
             return reader.additional_files< AdditionalFiles >();
         }
@@ -118,6 +209,7 @@ namespace geode
             {
                 return grid_percent;
             }
+            register_gdal_drivers();
             detail::GDALFile reader{ this->filename() };
             if( reader.dataset().GetRasterCount() == 0 )
             {
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/geosciences_io/mesh/internal/raster_level.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <gdal_priv.h>
+
+#include <geode/basic/range.hpp>
+
+#include <geode/geometry/coordinate_system.hpp>
+#include <geode/geometry/vector.hpp>
+
+namespace geode
+{
+    namespace internal
+    {
+        std::array< index_t, 2 > raster_level_size( GDALDataset& dataset,
+            const CoordinateSystem2D& coordinate_system,
+            const RasterLevelOptions& options )
+        {
+            const std::array< index_t, 2 > raster_size{
+                static_cast< index_t >( dataset.GetRasterXSize() ),
+                static_cast< index_t >( dataset.GetRasterYSize() )
+            };
+            if( options.overview )
+            {
+                OpenGeodeGeosciencesIOMeshException::check_exception(
+                    dataset.GetRasterCount() > 0, nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[raster_level_size] No bands found" );
+                const auto band = dataset.GetRasterBand( 1 );
+                const auto nb_overviews =
+                    static_cast< index_t >( band->GetOverviewCount() );
+                OpenGeodeGeosciencesIOMeshException::check_exception(
+                    options.overview.value() < nb_overviews, nullptr,
+                    OpenGeodeException::TYPE::data,
+                    "[raster_level_size] Overview ", options.overview.value(),
+                    " requested but the raster only has ", nb_overviews,
+                    " overviews" );
+                const auto overview = band->GetOverview(
+                    static_cast< int >( options.overview.value() ) );
+                return { static_cast< index_t >( overview->GetXSize() ),
+                    static_cast< index_t >( overview->GetYSize() ) };
+            }
+            if( !options.resolution )
+            {
+                return raster_size;
+            }
+            OpenGeodeGeosciencesIOMeshException::check_exception(
+                options.resolution.value() > 0, nullptr,
+                OpenGeodeException::TYPE::data,
+                "[raster_level_size] Resolution should be positive" );
+            std::array< index_t, 2 > level_size;
+            for( const auto d : LRange{ 2 } )
+            {
+                const auto extent = coordinate_system.direction( d ).length()
+                                    * raster_size[d];
+                const auto nb_pixels = std::clamp(
+                    std::floor( extent / options.resolution.value() ), 1.,
+                    std::max( 1., 1. * raster_size[d] ) );
+                level_size[d] = static_cast< index_t >( nb_pixels );
+            }
+            return level_size;
+        }
+
+        CoordinateSystem2D raster_level_coordinate_system(
+            const CoordinateSystem2D& coordinate_system,
+            const std::array< index_t, 2 >& raster_size,
+            const std::array< index_t, 2 >& level_size )
+        {
+            return CoordinateSystem2D{
+                { coordinate_system.direction( 0 )
+                        * ( static_cast< double >( raster_size[0] )
+                            / level_size[0] ),
+                    coordinate_system.direction( 1 )
+                        * ( static_cast< double >( raster_size[1] )
+                            / level_size[1] ) },
+                coordinate_system.origin()
+            };
+        }
+    } // namespace internal
+} // namespace geode
@@ -23,20 +23,35 @@
 
 #include <geode/geosciences_io/mesh/internal/vo_input.hpp>
 
+#include <async++.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <list>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
-#include <absl/strings/str_replace.h>
+#include <absl/algorithm/container.h>
+#include <absl/container/fixed_array.h>
+#include <absl/strings/ascii.h>
+#include <absl/strings/match.h>
+#include <absl/strings/numbers.h>
+#include <absl/strings/str_split.h>
 #include <absl/strings/strip.h>
 
 #include <geode/basic/attribute_manager.hpp>
 #include <geode/basic/file.hpp>
 #include <geode/basic/filename.hpp>
+#include <geode/basic/pimpl_impl.hpp>
 #include <geode/basic/string.hpp>
 #include <geode/basic/variable_attribute.hpp>
 
-#include <geode/geometry/distance.hpp>
 #include <geode/geometry/vector.hpp>
 
 #include <geode/mesh/builder/regular_grid_solid_builder.hpp>
@@ -44,127 +59,492 @@
 #include <geode/mesh/io/regular_grid_input.hpp>
 
 #include <geode/geosciences_io/mesh/internal/gocad_common.hpp>
+#include <geode/geosciences_io/mesh/internal/grid_window.hpp>
 
 namespace
 {
+    // Size in bytes of the property file parts read at once
+    static constexpr std::uint64_t PROPERTY_CHUNK_SIZE{ 16 * 1024 * 1024 };
+    // Number of values decoded by each task
+    static constexpr geode::index_t DECODE_BLOCK_SIZE{ 65536 };
+    // Size in bytes of the ASCII data file parts parsed by each task
+    static constexpr std::streamoff ASCII_CHUNK_SIZE{ 16 * 1024 * 1024 };
+
+    // Description of a property stored in its own binary file
+    struct VoxetProperty
+    {
+        std::string name;
+        std::string file;
+        geode::index_t element_size{ 4 };
+        bool is_ieee{ true };
+        bool is_signed{ false };
+        std::uint64_t offset{ 0 };
+        std::optional< double > no_data_value;
+    };
+
+    struct VoxetDataFiles
+    {
+        std::optional< std::string > ascii_data_file;
+        std::vector< VoxetProperty > properties;
+    };
+
+    std::string unquote( std::string_view value )
+    {
+        return geode::to_string( absl::StripSuffix(
+            absl::StripPrefix( absl::StripAsciiWhitespace( value ), "\"" ),
+            "\"" ) );
+    }
 
-    std::optional< std::string > get_data_file( std::ifstream& file )
+    // Splits the first tokens of the line, as many as the given span, and
+    // returns the rest of the line. Returns std::nullopt if the line has
+    // fewer tokens.
+    std::optional< std::string_view > split_first_tokens(
+        std::string_view line, absl::Span< std::string_view > tokens )
     {
-        const auto line =
-            geode::goto_keyword_if_it_exists( file, "ASCII_DATA_FILE" );
-        if( !line.has_value() )
+        static constexpr std::string_view WHITESPACES{ " \t\r\v\f" };
+        for( auto& token : tokens )
         {
-            return std::nullopt;
+            line = absl::StripLeadingAsciiWhitespace( line );
+            if( line.empty() )
+            {
+                return std::nullopt;
+            }
+            token = line.substr( 0, line.find_first_of( WHITESPACES ) );
+            line.remove_prefix( token.size() );
         }
-        return absl::StrReplaceAll(
-            line.value(), { { "ASCII_DATA_FILE ", "" }, { "\"", "" } } );
+        return absl::StripAsciiWhitespace( line );
     }
 
-    class VOInputImpl
+    void read_property_record( std::string_view keyword,
+        std::string_view line,
+        VoxetDataFiles& data_files )
+    {
+        const auto tokens = geode::string_split( line );
+        geode::index_t property_id;
+        if( tokens.size() < 3 || !absl::SimpleAtoi( tokens[1], &property_id )
+            || property_id == 0 )
+        {
+            return;
+        }
+        if( data_files.properties.size() < property_id )
+        {
+            data_files.properties.resize( property_id );
+        }
+        auto& property = data_files.properties[property_id - 1];
+        const auto value = line.substr( tokens[2].data() - line.data() );
+        if( keyword == "PROPERTY" )
+        {
+            property.name = unquote( value );
+        }
+        else if( keyword == "PROP_FILE" )
+        {
+            property.file = unquote( value );
+        }
+        else if( keyword == "PROP_ESIZE" )
+        {
+            property.element_size = geode::string_to_index( tokens[2] );
+        }
+        else if( keyword == "PROP_ETYPE" )
+        {
+            property.is_ieee = tokens[2] == "IEEE";
+        }
+        else if( keyword == "PROP_SIGNED" )
+        {
+            property.is_signed = tokens[2] != "0";
+        }
+        else if( keyword == "PROP_OFFSET" )
+        {
+            property.offset = geode::string_to_index( tokens[2] );
+        }
+        else if( keyword == "PROP_NO_DATA_VALUE" )
+        {
+            property.no_data_value = geode::string_to_double( tokens[2] );
+        }
+    }
+
+    VoxetDataFiles read_data_files( std::ifstream& file )
+    {
+        VoxetDataFiles data_files;
+        std::string line;
+        while( std::getline( file, line ) )
+        {
+            const auto record = absl::StripAsciiWhitespace( line );
+            const auto keyword = record.substr( 0, record.find( ' ' ) );
+            if( keyword == "ASCII_DATA_FILE" )
+            {
+                data_files.ascii_data_file =
+                    unquote( record.substr( keyword.size() ) );
+            }
+            else if( absl::StartsWith( keyword, "PROP" ) )
+            {
+                read_property_record( keyword, record, data_files );
+            }
+        }
+        return data_files;
+    }
+
+    // Splits the file from the current position to its end in byte ranges
+    // starting at the beginning of a line.
+    std::vector< std::streamoff > line_chunk_limits( std::ifstream& file )
+    {
+        std::vector< std::streamoff > limits{ file.tellg() };
+        file.seekg( 0, std::ios::end );
+        const std::streamoff file_end = file.tellg();
+        std::string line;
+        while( limits.back() + ASCII_CHUNK_SIZE < file_end )
+        {
+            file.seekg( limits.back() + ASCII_CHUNK_SIZE );
+            if( !std::getline( file, line ) || file.tellg() < 0 )
+            {
+                break;
+            }
+            limits.push_back( file.tellg() );
+        }
+        limits.push_back( file_end );
+        return limits;
+    }
+
+    // Data rows are usually sorted by cell, i varying first: the cell of a
+    // row following its predecessor is deduced without computing its index.
+    class RowCells
     {
     public:
-        VOInputImpl( std::string_view filename, geode::RegularGrid3D& grid )
-            : file_{ geode::to_string( filename ), std::ios::binary },
-              file_folder_{
-                  geode::filepath_without_filename( filename ).string()
-              },
-              grid_( grid ),
-              builder_{ geode::RegularGridBuilder3D::create( grid ) }
+        explicit RowCells( const geode::RegularGrid3D& grid ) : grid_( grid )
         {
-            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
-                file_.good(), nullptr, geode::OpenGeodeException::TYPE::data,
-                "Error while opening file: ", filename );
         }
 
-        void read_file()
+        geode::index_t cell( const std::array< geode::index_t, 3 >& indices )
         {
-            if( !geode::goto_keyword_if_it_exists( file_, "GOCAD Voxet" ) )
+            if( !next_cell_ || indices != next_indices_ )
             {
-                throw geode::OpenGeodeGeosciencesIOMeshException{ nullptr,
-                    geode::OpenGeodeException::TYPE::data,
-                    "[VOInput] Cannot find Voxet in the file" };
+                next_cell_ = grid_.cell_index( indices );
             }
-            const auto header = geode::internal::read_header( file_ );
-            if( header.name )
+            const auto cell = next_cell_.value();
+            next_indices_ = indices;
+            for( const auto direction : geode::LRange{ 3 } )
             {
-                builder_->set_name( header.name.value() );
+                if( ++next_indices_[direction]
+                    < grid_.nb_cells_in_direction( direction ) )
+                {
+                    next_cell_ = cell + 1;
+                    return cell;
+                }
+                next_indices_[direction] = 0;
             }
-            geode::internal::read_CRS( file_ );
-            initialize_grid();
-            read_data_file();
+            next_cell_ = std::nullopt;
+            return cell;
         }
 
     private:
-        void initialize_grid()
-        {
-            auto line = geode::goto_keyword( file_, "AXIS_O" );
-            auto origin = read_coord( line, 1 );
-            const auto grid_size = read_grid_size( origin );
-            auto cells_number = read_cells_number();
-            auto cells_length = compute_cells_length( grid_size, cells_number );
+        const geode::RegularGrid3D& grid_;
+        std::optional< geode::index_t > next_cell_;
+        std::array< geode::index_t, 3 > next_indices_;
+    };
 
-            builder_->initialize_grid( std::move( origin ),
-                std::move( cells_number ), std::move( cells_length ) );
+    VoxetDataFiles read_voxet_data_files( std::string_view filename )
+    {
+        std::ifstream file{ geode::to_string( filename ), std::ios::binary };
+        geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+            file.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+            "Error while opening file: ", filename );
+        return read_data_files( file );
+    }
+
+    // Voxet property files are big-endian
+    template < typename Bits >
+    Bits big_endian_bits( const char* bytes )
+    {
+        const auto* data = reinterpret_cast< const unsigned char* >( bytes );
+        Bits bits{ 0 };
+        for( std::size_t byte = 0; byte < sizeof( Bits ); byte++ )
+        {
+            bits = static_cast< Bits >( ( bits << 8 ) | data[byte] );
         }
+        return bits;
+    }
 
-        std::array< double, 3 > read_grid_size( const geode::Point3D& origin )
+    // Decodes one value out of stride into consecutive cells
+    template < typename Value, typename Bits >
+    void decode_values( const char* bytes,
+        geode::index_t first_cell,
+        geode::index_t nb_values,
+        geode::index_t stride,
+        geode::VariableAttribute< double >& attribute )
+    {
+        for( const auto value_id : geode::Range{ nb_values } )
         {
-            std::array< double, 3 > cells_length;
-            auto line = geode::goto_keyword( file_, "AXIS_U" );
-            cells_length[0] =
-                geode::point_point_distance( origin, read_coord( line, 1 ) );
-            line = geode::goto_keyword( file_, "AXIS_V" );
-            cells_length[1] =
-                geode::point_point_distance( origin, read_coord( line, 1 ) );
-            line = geode::goto_keyword( file_, "AXIS_W" );
-            cells_length[2] =
-                geode::point_point_distance( origin, read_coord( line, 1 ) );
-            return cells_length;
+            const auto bits = big_endian_bits< Bits >(
+                bytes + std::size_t{ value_id } * stride * sizeof( Bits ) );
+            Value value;
+            std::memcpy( &value, &bits, sizeof( Value ) );
+            attribute.set_value(
+                first_cell + value_id, static_cast< double >( value ) );
         }
+    }
 
-        std::array< geode::index_t, 3 > read_cells_number()
+    using ValuesDecoder = void ( * )( const char*,
+        geode::index_t,
+        geode::index_t,
+        geode::index_t,
+        geode::VariableAttribute< double >& );
+
+    ValuesDecoder values_decoder( const VoxetProperty& property )
+    {
+        if( property.is_ieee && property.element_size == 4 )
         {
-            auto line = geode::goto_keyword( file_, "AXIS_N" );
-            const auto tokens = geode::string_split( line );
-            return { geode::string_to_index( tokens[1] ),
-                geode::string_to_index( tokens[2] ),
-                geode::string_to_index( tokens[3] ) };
+            return &decode_values< float, std::uint32_t >;
+        }
+        if( property.is_ieee && property.element_size == 8 )
+        {
+            return &decode_values< double, std::uint64_t >;
+        }
+        if( !property.is_ieee && property.element_size == 1 )
+        {
+            return property.is_signed
+                       ? &decode_values< std::int8_t, std::uint8_t >
+                       : &decode_values< std::uint8_t, std::uint8_t >;
         }
+        if( !property.is_ieee && property.element_size == 2 )
+        {
+            return property.is_signed
+                       ? &decode_values< std::int16_t, std::uint16_t >
+                       : &decode_values< std::uint16_t, std::uint16_t >;
+        }
+        if( !property.is_ieee && property.element_size == 4 )
+        {
+            return property.is_signed
+                       ? &decode_values< std::int32_t, std::uint32_t >
+                       : &decode_values< std::uint32_t, std::uint32_t >;
+        }
+        throw geode::OpenGeodeGeosciencesIOMeshException{ nullptr,
+            geode::OpenGeodeException::TYPE::data,
+            "[VOInput] Unsupported element size ", property.element_size,
+            " for property ", property.name };
+    }
 
-        std::array< double, 3 > compute_cells_length(
-            const std::array< double, 3 >& grid_size,
-            const std::array< geode::index_t, 3 >& nb_cells )
+    geode::Point3D read_coord( std::string_view line, geode::index_t offset )
+    {
+        const auto tokens = geode::string_split( line );
+        geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+            tokens.size() == 3 + offset, nullptr,
+            geode::OpenGeodeException::TYPE::data,
+            "[VOInput::read_coord] Wrong number of tokens" );
+        return geode::Point3D{ { geode::string_to_double( tokens[offset] ),
+            geode::string_to_double( tokens[1 + offset] ),
+            geode::string_to_double( tokens[2 + offset] ) } };
+    }
+
+    // Voxet axes AXIS_U, AXIS_V and AXIS_W are vectors spanning the whole
+    // grid from AXIS_O
+    struct VoxetAxes
+    {
+        geode::internal::GridWindow< 3 > window(
+            const geode::internal::GridWindowOptions< 3 >& options ) const
         {
-            std::array< double, 3 > result;
-            for( const auto axis_id : geode::LRange{ 3 } )
-            {
-                result[axis_id] = grid_size[axis_id] / nb_cells[axis_id];
-            }
-            return result;
+            return { options, cells_number,
+                [this]( const geode::Point3D& point ) {
+                    const geode::Vector3D vector{ origin, point };
+                    std::array< double, 3 > coordinates;
+                    for( const auto axis_id : geode::LRange{ 3 } )
+                    {
+                        coordinates[axis_id] =
+                            inverse_directions[axis_id].dot( vector );
+                    }
+                    return coordinates;
+                } };
         }
 
-        geode::Point3D read_coord(
-            std::string_view line, geode::index_t offset ) const
+        // Rows of the inverse of the matrix whose columns are the cell
+        // directions
+        void compute_inverse_directions()
         {
-            const auto tokens = geode::string_split( line );
+            const auto& u = cell_directions[0];
+            const auto& v = cell_directions[1];
+            const auto& w = cell_directions[2];
+            const auto determinant = u.dot( v.cross( w ) );
             geode::OpenGeodeGeosciencesIOMeshException::check_exception(
-                tokens.size() == 3 + offset, nullptr,
+                determinant != 0, nullptr,
                 geode::OpenGeodeException::TYPE::data,
-                "[VOInput::read_coord] Wrong number of tokens" );
-            return geode::Point3D{ { geode::string_to_double( tokens[offset] ),
-                geode::string_to_double( tokens[1 + offset] ),
-                geode::string_to_double( tokens[2 + offset] ) } };
+                "[VOInput] Degenerated Voxet axes" );
+            inverse_directions = { v.cross( w ) / determinant,
+                w.cross( u ) / determinant, u.cross( v ) / determinant };
         }
 
-        void read_data_file()
+        geode::Point3D origin;
+        std::array< geode::index_t, 3 > cells_number;
+        std::array< geode::Vector3D, 3 > cell_directions;
+        std::array< geode::Vector3D, 3 > inverse_directions;
+    };
+
+    VoxetAxes read_axes( std::ifstream& file )
+    {
+        VoxetAxes axes;
+        auto line = geode::goto_keyword( file, "AXIS_O" );
+        axes.origin = read_coord( line, 1 );
+        std::array< geode::Point3D, 3 > grid_axes;
+        const std::array< std::string_view, 3 > keywords{ "AXIS_U", "AXIS_V",
+            "AXIS_W" };
+        for( const auto axis_id : geode::LRange{ 3 } )
         {
-            const auto data_file_name = get_data_file( file_ );
+            line = geode::goto_keyword( file, keywords[axis_id] );
+            grid_axes[axis_id] = read_coord( line, 1 );
+        }
+        line = geode::goto_keyword( file, "AXIS_N" );
+        const auto tokens = geode::string_split( line );
+        axes.cells_number = { geode::string_to_index( tokens[1] ),
+            geode::string_to_index( tokens[2] ),
+            geode::string_to_index( tokens[3] ) };
+        for( const auto axis_id : geode::LRange{ 3 } )
+        {
+            axes.cell_directions[axis_id] =
+                geode::Vector3D{ grid_axes[axis_id] }
+                / axes.cells_number[axis_id];
+        }
+        axes.compute_inverse_directions();
+        return axes;
+    }
+
+    // Reads the cell properties of a Voxet from its ASCII data file and its
+    // property files.
+    class VoxetDataReader
+    {
+    public:
+        VoxetDataReader( std::string_view filename,
+            VoxetDataFiles data_files,
+            geode::RegularGrid3D& grid,
+            geode::internal::GridWindow< 3 > window,
+            const std::array< geode::index_t, 3 >& file_cells_number )
+            : file_folder_{ geode::filepath_without_filename( filename )
+                                .string() },
+              data_files_( std::move( data_files ) ),
+              grid_( grid ),
+              window_( std::move( window ) ),
+              file_cells_number_( file_cells_number )
+        {
+            bool has_property_file{ false };
+            for( const auto& property : data_files_.properties )
+            {
+                if( property.file.empty() )
+                {
+                    continue;
+                }
+                geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                    !property.name.empty(), nullptr,
+                    geode::OpenGeodeException::TYPE::data,
+                    "[VOInput] Missing name for property file ",
+                    property.file );
+                has_property_file = true;
+            }
             geode::OpenGeodeGeosciencesIOMeshException::check_exception(
-                data_file_name.has_value(), nullptr,
-                geode::OpenGeodeException::TYPE::data,
+                data_files_.ascii_data_file.has_value() || has_property_file,
+                nullptr, geode::OpenGeodeException::TYPE::data,
                 "[VOInput] No data file record" );
-            const auto data_file_path = absl::StrCat( file_folder_,
-                absl::StripSuffix( data_file_name.value(), "\r" ) );
+            if( data_files_.ascii_data_file )
+            {
+                read_ascii_header();
+            }
+        }
+
+        std::vector< std::string_view > property_names() const
+        {
+            std::vector< std::string_view > names{ ascii_columns_.begin(),
+                ascii_columns_.end() };
+            for( const auto& property : data_files_.properties )
+            {
+                if( !property.file.empty() )
+                {
+                    names.push_back( property.name );
+                }
+            }
+            return names;
+        }
+
+        void read_all_properties()
+        {
+            read_properties( property_names() );
+        }
+
+        // Properties are read into cell attributes created first since the
+        // attribute manager is not thread safe. ASCII columns are parsed
+        // together, and each property file is read by its own task.
+        void read_properties( absl::Span< const std::string_view > names )
+        {
+            absl::FixedArray<
+                std::shared_ptr< geode::VariableAttribute< double > > >
+                ascii_attributes( ascii_columns_.size() );
+            std::vector< std::pair< const VoxetProperty*,
+                std::shared_ptr< geode::VariableAttribute< double > > > >
+                property_attributes;
+            bool has_ascii_attributes{ false };
+            for( const auto name : names )
+            {
+                const auto column = absl::c_find( ascii_columns_, name );
+                if( column != ascii_columns_.end() )
+                {
+                    ascii_attributes[static_cast< std::size_t >(
+                        column - ascii_columns_.begin() )] =
+                        create_attribute( name, 0 );
+                    has_ascii_attributes = true;
+                    continue;
+                }
+                const auto& property = binary_property( name );
+                property_attributes.emplace_back( &property,
+                    create_attribute(
+                        name, property.no_data_value.value_or( 0 ) ) );
+            }
+            async::parallel_invoke(
+                [this, has_ascii_attributes, &ascii_attributes] {
+                    if( has_ascii_attributes )
+                    {
+                        read_ascii_data_file( ascii_attributes );
+                    }
+                },
+                [this, &property_attributes] {
+                    async::parallel_for(
+                        async::irange(
+                            std::size_t{ 0 }, property_attributes.size() ),
+                        [this, &property_attributes](
+                            std::size_t property_id ) {
+                            const auto& property_attribute =
+                                property_attributes[property_id];
+                            read_property_file( *property_attribute.first,
+                                *property_attribute.second );
+                        } );
+                } );
+        }
+
+    private:
+        std::shared_ptr< geode::VariableAttribute< double > > create_attribute(
+            std::string_view name, double default_value )
+        {
+            return grid_.cell_attribute_manager()
+                .find_or_create_attribute< geode::VariableAttribute, double >(
+                    name, default_value );
+        }
+
+        const VoxetProperty& binary_property( std::string_view name ) const
+        {
+            for( const auto& property : data_files_.properties )
+            {
+                if( !property.file.empty() && property.name == name )
+                {
+                    return property;
+                }
+            }
+            throw geode::OpenGeodeGeosciencesIOMeshException{ nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[VOInput] Unknown property ", name };
+        }
+
+        std::string ascii_data_file_path() const
+        {
+            return absl::StrCat(
+                file_folder_, data_files_.ascii_data_file.value() );
+        }
+
+        void read_ascii_header()
+        {
+            const auto data_file_path = ascii_data_file_path();
             std::ifstream data_file{ data_file_path, std::ios::binary };
             geode::OpenGeodeGeosciencesIOMeshException::check_exception(
                 data_file.good(), nullptr,
@@ -173,46 +553,296 @@ namespace
             std::string line;
             std::getline( data_file, line );
             std::getline( data_file, line );
-            auto tokens = geode::string_split( line );
-            absl::FixedArray<
-                std::shared_ptr< geode::VariableAttribute< double > > >
-                data_attributes( tokens.size() - 4 );
-            for( const auto attribute_id : geode::Indices{ data_attributes } )
+            const auto tokens = geode::string_split( line );
+            for( std::size_t column = 4; column < tokens.size(); column++ )
             {
-                data_attributes[attribute_id] =
-                    grid_.cell_attribute_manager()
-                        .find_or_create_attribute< geode::VariableAttribute,
-                            double >( tokens[4 + attribute_id], 0 );
+                ascii_columns_.emplace_back( tokens[column] );
             }
             std::getline( data_file, line );
-            while( std::getline( data_file, line ) )
+            ascii_data_begin_ = data_file.tellg();
+        }
+
+        void read_ascii_data_file( absl::Span< const std::shared_ptr<
+                geode::VariableAttribute< double > > > data_attributes ) const
+        {
+            const auto data_file_path = ascii_data_file_path();
+            std::ifstream data_file{ data_file_path, std::ios::binary };
+            data_file.seekg( ascii_data_begin_ );
+            const auto chunk_limits = line_chunk_limits( data_file );
+            async::parallel_for(
+                async::irange( std::size_t{ 0 }, chunk_limits.size() - 1 ),
+                [&]( std::size_t chunk ) {
+                    std::string text(
+                        static_cast< std::size_t >(
+                            chunk_limits[chunk + 1] - chunk_limits[chunk] ),
+                        '\0' );
+                    std::ifstream chunk_file{ data_file_path,
+                        std::ios::binary };
+                    chunk_file.seekg( chunk_limits[chunk] );
+                    chunk_file.read( text.data(),
+                        static_cast< std::streamsize >( text.size() ) );
+                    read_ascii_rows( text, data_attributes );
+                } );
+        }
+
+        // Rows of different chunks refer to different cells, their values
+        // are written in parallel into the attributes. Lines are split up to
+        // the last column with an attribute only, and columns without
+        // attribute are not converted. The number of tokens is fully checked
+        // only when the last column is read.
+        void read_ascii_rows( std::string_view text,
+            absl::Span< const std::shared_ptr<
+                geode::VariableAttribute< double > > > data_attributes ) const
+        {
+            const auto is_whole_grid =
+                window_.is_whole_grid( file_cells_number_ );
+            RowCells row_cells{ grid_ };
+            const auto nb_line_tokens = data_attributes.size() + 3;
+            std::size_t nb_tokens{ 3 };
+            for( const auto attribute_id : geode::Indices{ data_attributes } )
+            {
+                if( data_attributes[attribute_id] )
+                {
+                    nb_tokens = attribute_id + 4;
+                }
+            }
+            absl::FixedArray< std::string_view > tokens( nb_tokens );
+            for( const auto line : absl::StrSplit( text, '\n' ) )
             {
-                tokens = geode::string_split( line );
+                if( absl::StripAsciiWhitespace( line ).empty() )
+                {
+                    continue;
+                }
+                const auto rest =
+                    split_first_tokens( line, absl::MakeSpan( tokens ) );
                 geode::OpenGeodeGeosciencesIOMeshException::check_exception(
-                    tokens.size() == data_attributes.size() + 3, nullptr,
-                    geode::OpenGeodeException::TYPE::data,
+                    rest && ( nb_tokens < nb_line_tokens || rest->empty() ),
+                    nullptr, geode::OpenGeodeException::TYPE::data,
                     "[VOInput::read_data_file] Wrong number of tokens in line, "
-                    "got",
-                    tokens.size(), ", should have ",
-                    data_attributes.size() + 3 );
-                const auto cell_id =
-                    grid_.cell_index( { geode::string_to_index( tokens[0] ),
-                        geode::string_to_index( tokens[1] ),
-                        geode::string_to_index( tokens[2] ) } );
+                    "should have ",
+                    nb_line_tokens );
+                const std::array< geode::index_t, 3 > file_cell{
+                    geode::string_to_index( tokens[0] ),
+                    geode::string_to_index( tokens[1] ),
+                    geode::string_to_index( tokens[2] )
+                };
+                geode::index_t cell_id;
+                if( is_whole_grid )
+                {
+                    cell_id = row_cells.cell( file_cell );
+                }
+                else if( const auto window_cell =
+                             window_.window_cell( file_cell ) )
+                {
+                    cell_id = grid_.cell_index( window_cell.value() );
+                }
+                else
+                {
+                    continue;
+                }
                 for( const auto attribute_id :
                     geode::Indices{ data_attributes } )
                 {
-                    data_attributes[attribute_id]->set_value( cell_id,
-                        geode::string_to_double( tokens[3 + attribute_id] ) );
+                    if( data_attributes[attribute_id] )
+                    {
+                        data_attributes[attribute_id]->set_value( cell_id,
+                            geode::string_to_double(
+                                tokens[3 + attribute_id] ) );
+                    }
                 }
             }
         }
 
+        // Property files store one value per cell, u varying first then v
+        // and w, which is the cell index order of the grid.
+        void read_property_file( const VoxetProperty& property,
+            geode::VariableAttribute< double >& attribute ) const
+        {
+            const auto path = absl::StrCat( file_folder_, property.file );
+            std::ifstream file{ path, std::ios::binary | std::ios::ate };
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                file.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+                "[VOInput] Cannot open property file: ", path );
+            const auto decode = values_decoder( property );
+            const auto nb_cells = std::uint64_t{ file_cells_number_[0] }
+                                  * file_cells_number_[1]
+                                  * file_cells_number_[2];
+            const auto file_size =
+                static_cast< std::uint64_t >( file.tellg() );
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                file_size >= property.offset + nb_cells * property.element_size,
+                nullptr, geode::OpenGeodeException::TYPE::data,
+                "[VOInput] Property file ", path, " is too small for ",
+                nb_cells, " cells" );
+            if( !window_.is_whole_grid( file_cells_number_ ) )
+            {
+                read_property_window( property, path, decode, attribute );
+                return;
+            }
+            file.seekg( property.offset );
+            const auto chunk_nb_cells = std::min(
+                PROPERTY_CHUNK_SIZE / property.element_size, nb_cells );
+            std::vector< char > buffer(
+                chunk_nb_cells * property.element_size );
+            for( std::uint64_t first_cell = 0; first_cell < nb_cells;
+                 first_cell += chunk_nb_cells )
+            {
+                const auto nb_values = static_cast< geode::index_t >(
+                    std::min( chunk_nb_cells, nb_cells - first_cell ) );
+                file.read( buffer.data(),
+                    static_cast< std::streamsize >(
+                        std::size_t{ nb_values } * property.element_size ) );
+                geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                    file.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+                    "[VOInput] Error while reading property file ", path );
+                const auto nb_blocks =
+                    ( nb_values + DECODE_BLOCK_SIZE - 1 ) / DECODE_BLOCK_SIZE;
+                async::parallel_for( async::irange( geode::index_t{ 0 },
+                                         nb_blocks ),
+                    [&]( geode::index_t block ) {
+                        const auto first_value = block * DECODE_BLOCK_SIZE;
+                        decode( buffer.data()
+                                    + std::size_t{ first_value }
+                                          * property.element_size,
+                            static_cast< geode::index_t >( first_cell )
+                                + first_value,
+                            std::min( DECODE_BLOCK_SIZE,
+                                nb_values - first_value ),
+                            1, attribute );
+                    } );
+            }
+        }
+
+        // Only the file rows holding window cells are read, each from its
+        // first to its last sampled value. Layers are read in parallel.
+        void read_property_window( const VoxetProperty& property,
+            const std::string& path,
+            ValuesDecoder decode,
+            geode::VariableAttribute< double >& attribute ) const
+        {
+            const auto nb_u = window_.nb_cells( 0 );
+            const auto row_size = ( std::size_t{ nb_u - 1 } * window_.stride()
+                                      + 1 )
+                                  * property.element_size;
+            async::parallel_for(
+                async::irange( geode::index_t{ 0 }, window_.nb_cells( 2 ) ),
+                [&]( geode::index_t k ) {
+                    std::ifstream file{ path, std::ios::binary };
+                    std::vector< char > buffer( row_size );
+                    const auto w = window_.file_cell( 2, k );
+                    for( const auto j : geode::Range{ window_.nb_cells( 1 ) } )
+                    {
+                        const auto v = window_.file_cell( 1, j );
+                        const auto first_value =
+                            window_.file_cell( 0, 0 )
+                            + std::uint64_t{ file_cells_number_[0] }
+                                  * ( v
+                                      + std::uint64_t{ file_cells_number_[1] }
+                                            * w );
+                        file.seekg( static_cast< std::streamoff >(
+                            property.offset
+                            + first_value * property.element_size ) );
+                        file.read( buffer.data(),
+                            static_cast< std::streamsize >( row_size ) );
+                        geode::OpenGeodeGeosciencesIOMeshException::
+                            check_exception( file.good(), nullptr,
+                                geode::OpenGeodeException::TYPE::data,
+                                "[VOInput] Error while reading property "
+                                "file ",
+                                path );
+                        decode( buffer.data(), grid_.cell_index( { 0, j, k } ),
+                            nb_u, window_.stride(), attribute );
+                    }
+                } );
+        }
+
     private:
-        std::ifstream file_;
         std::string file_folder_;
+        VoxetDataFiles data_files_;
         geode::RegularGrid3D& grid_;
+        geode::internal::GridWindow< 3 > window_;
+        std::array< geode::index_t, 3 > file_cells_number_;
+        std::vector< std::string > ascii_columns_;
+        std::streamoff ascii_data_begin_{ 0 };
+    };
+
+    VoxetDataReader voxet_data_reader( std::string_view filename,
+        geode::RegularGrid3D& grid,
+        const geode::internal::GridWindowOptions< 3 >& window_options )
+    {
+        std::ifstream file{ geode::to_string( filename ), std::ios::binary };
+        geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+            file.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+            "Error while opening file: ", filename );
+        const auto axes = read_axes( file );
+        return { filename, read_data_files( file ), grid,
+            axes.window( window_options ), axes.cells_number };
+    }
+
+    class VOInputImpl
+    {
+    public:
+        VOInputImpl( std::string_view filename,
+            geode::RegularGrid3D& grid,
+            const geode::internal::VOInputOptions& options )
+            : filename_( filename ),
+              file_{ geode::to_string( filename ), std::ios::binary },
+              grid_( grid ),
+              options_( options ),
+              builder_{ geode::RegularGridBuilder3D::create( grid ) }
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                file_.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+                "Error while opening file: ", filename );
+        }
+
+        void read_file()
+        {
+            if( !geode::goto_keyword_if_it_exists( file_, "GOCAD Voxet" ) )
+            {
+                throw geode::OpenGeodeGeosciencesIOMeshException{ nullptr,
+                    geode::OpenGeodeException::TYPE::data,
+                    "[VOInput] Cannot find Voxet in the file" };
+            }
+            const auto header = geode::internal::read_header( file_ );
+            if( header.name )
+            {
+                builder_->set_name( header.name.value() );
+            }
+            geode::internal::read_CRS( file_ );
+            initialize_grid();
+            if( options_.load_properties )
+            {
+                VoxetDataReader{ filename_, read_data_files( file_ ), grid_,
+                    axes_.window( options_.window ), axes_.cells_number }
+                    .read_all_properties();
+            }
+        }
+
+    private:
+        void initialize_grid()
+        {
+            axes_ = read_axes( file_ );
+            const auto window = axes_.window( options_.window );
+            auto origin = axes_.origin;
+            std::array< geode::Vector3D, 3 > cell_directions;
+            for( const auto axis_id : geode::LRange{ 3 } )
+            {
+                const auto& direction = axes_.cell_directions[axis_id];
+                origin = origin + direction * window.begin( axis_id );
+                cell_directions[axis_id] = direction * window.stride();
+            }
+            builder_->initialize_grid(
+                origin, window.cells_number(), cell_directions );
+        }
+
+    private:
+        std::string_view filename_;
+        std::ifstream file_;
+        geode::RegularGrid3D& grid_;
+        const geode::internal::VOInputOptions& options_;
         std::unique_ptr< geode::RegularGridBuilder3D > builder_;
+        VoxetAxes axes_;
     };
 } // namespace
 
@@ -223,27 +853,164 @@ namespace geode
         std::unique_ptr< RegularGrid3D > VOInput::read( const MeshImpl& impl )
         {
             auto voxet = RegularGrid3D::create( impl );
-            VOInputImpl reader{ filename(), *voxet };
+            VOInputImpl reader{ filename(), *voxet, options_ };
             reader.read_file();
             return voxet;
         }
 
         auto VOInput::additional_files() const -> AdditionalFiles
         {
-            std::ifstream file{ geode::to_string( filename() ),
-                std::ios::binary };
-            const auto data_file = get_data_file( file );
-            file.close();
-            if( !data_file.has_value() )
+            const auto data_files = read_voxet_data_files( filename() );
+            // Data file names are relative to the Voxet file folder
+            const auto file_folder =
+                filepath_without_filename( filename() ).string();
+            AdditionalFiles missing;
+            if( data_files.ascii_data_file )
             {
-                return {};
+                missing.mandatory_files.emplace_back(
+                    data_files.ascii_data_file.value(),
+                    file_exists( absl::StrCat( file_folder,
+                        data_files.ascii_data_file.value() ) ) );
+            }
+            for( const auto& property : data_files.properties )
+            {
+                if( !property.file.empty() )
+                {
+                    missing.mandatory_files.emplace_back( property.file,
+                        file_exists(
+                            absl::StrCat( file_folder, property.file ) ) );
+                }
             }
-            AdditionalFiles missing;
-            missing.mandatory_files.emplace_back(
-                data_file.value(), file_exists( data_file.value() ) );
             return missing;
         }
 
+        class VoxetPropertyLoader::Impl
+        {
+        public:
+            Impl( std::string_view filename,
+                RegularGrid3D& grid,
+                const VOInputOptions& options )
+                : grid_( grid ),
+                  reader_{ voxet_data_reader( filename, grid, options.window ) }
+            {
+            }
+
+            std::vector< std::string_view > property_names() const
+            {
+                return reader_.property_names();
+            }
+
+            bool is_property_loaded( std::string_view name ) const
+            {
+                std::lock_guard< std::mutex > lock{ mutex_ };
+                return absl::c_linear_search( loaded_, name );
+            }
+
+            std::shared_ptr< ReadOnlyAttribute< double > > property(
+                std::string_view name )
+            {
+                std::lock_guard< std::mutex > lock{ mutex_ };
+                const auto loaded = absl::c_find( loaded_, name );
+                if( loaded != loaded_.end() )
+                {
+                    loaded_.splice( loaded_.end(), loaded_, loaded );
+                }
+                else
+                {
+                    const std::array< std::string_view, 1 > names{ name };
+                    reader_.read_properties( names );
+                    loaded_.emplace_back( name );
+                    evict_properties();
+                }
+                return grid_.cell_attribute_manager().find_attribute< double >(
+                    name );
+            }
+
+            void unload_property( std::string_view name )
+            {
+                std::lock_guard< std::mutex > lock{ mutex_ };
+                const auto loaded = absl::c_find( loaded_, name );
+                if( loaded == loaded_.end() )
+                {
+                    return;
+                }
+                grid_.cell_attribute_manager().delete_attribute( name );
+                loaded_.erase( loaded );
+            }
+
+            void set_memory_budget( std::size_t budget )
+            {
+                std::lock_guard< std::mutex > lock{ mutex_ };
+                memory_budget_ = budget;
+                evict_properties();
+            }
+
+        private:
+            // Requires mutex_ to be locked
+            void evict_properties()
+            {
+                const auto property_size =
+                    std::size_t{ grid_.nb_cells() } * sizeof( double );
+                while( loaded_.size() > 1
+                       && loaded_.size() * property_size > memory_budget_ )
+                {
+                    grid_.cell_attribute_manager().delete_attribute(
+                        loaded_.front() );
+                    loaded_.pop_front();
+                }
+            }
+
+        private:
+            RegularGrid3D& grid_;
+            VoxetDataReader reader_;
+            // Loaded properties, from the least to the most recently accessed
+            std::list< std::string > loaded_;
+            std::size_t memory_budget_{ std::numeric_limits<
+                std::size_t >::max() };
+            // Guards the reader, the loaded list and the grid attributes
+            mutable std::mutex mutex_;
+        };
+
+        VoxetPropertyLoader::VoxetPropertyLoader( std::string_view filename,
+            RegularGrid3D& grid,
+            const VOInputOptions& options )
+            : impl_{ filename, grid, options }
+        {
+        }
+
+        VoxetPropertyLoader::VoxetPropertyLoader(
+            VoxetPropertyLoader&& ) noexcept = default;
+
+        VoxetPropertyLoader::~VoxetPropertyLoader() = default;
+
+        std::vector< std::string_view >
+            VoxetPropertyLoader::property_names() const
+        {
+            return impl_->property_names();
+        }
+
+        bool VoxetPropertyLoader::is_property_loaded(
+            std::string_view name ) const
+        {
+            return impl_->is_property_loaded( name );
+        }
+
+        std::shared_ptr< ReadOnlyAttribute< double > >
+            VoxetPropertyLoader::property( std::string_view name )
+        {
+            return impl_->property( name );
+        }
+
+        void VoxetPropertyLoader::unload_property( std::string_view name )
+        {
+            impl_->unload_property( name );
+        }
+
+        void VoxetPropertyLoader::set_memory_budget( std::size_t budget )
+        {
+            impl_->set_memory_budget( budget );
+        }
+
         Percentage VOInput::is_loadable() const
         {
             std::ifstream file{ to_string( this->filename() ),
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/geosciences_io/mesh/internal/vo_output.hpp>
+
+#include <async++.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <absl/algorithm/container.h>
+#include <absl/strings/ascii.h>
+#include <absl/strings/str_cat.h>
+
+#include <geode/basic/attribute_manager.hpp>
+#include <geode/basic/filename.hpp>
+#include <geode/basic/logger.hpp>
+
+#include <geode/mesh/core/regular_grid_solid.hpp>
+
+#include <geode/geosciences_io/mesh/internal/gocad_common.hpp>
+
+namespace
+{
+    // Number of cells written at once in a property file
+    static constexpr geode::index_t PROPERTY_CHUNK_SIZE{ 4 * 1024 * 1024 };
+    // Number of values encoded by each task
+    static constexpr geode::index_t ENCODE_BLOCK_SIZE{ 65536 };
+    static constexpr geode::index_t ELEMENT_SIZE{ 4 };
+    static constexpr double NO_DATA_VALUE{ -99999. };
+
+    // Voxet property files are big-endian
+    void encode_value( float value, char* bytes )
+    {
+        std::uint32_t bits;
+        std::memcpy( &bits, &value, sizeof( bits ) );
+        bytes[0] = static_cast< char >( bits >> 24 );
+        bytes[1] = static_cast< char >( bits >> 16 );
+        bytes[2] = static_cast< char >( bits >> 8 );
+        bytes[3] = static_cast< char >( bits );
+    }
+
+    // One item of a cell attribute, written as its own property
+    struct Property
+    {
+        std::shared_ptr< geode::AttributeBase > attribute;
+        geode::local_index_t item;
+        std::string name;
+        std::string file;
+    };
+
+    class VOOutputImpl
+    {
+    public:
+        static constexpr char EOL{ '\n' };
+        static constexpr char SPACE{ ' ' };
+
+        VOOutputImpl(
+            std::string_view filename, const geode::RegularGrid3D& grid )
+            : filename_( filename ),
+              folder_{ geode::filepath_without_filename( filename ).string() },
+              file_{ geode::to_string( filename ) },
+              grid_( grid )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                file_.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+                "Error while opening file: ", filename );
+            file_.precision( std::numeric_limits< double >::max_digits10 );
+        }
+
+        std::vector< std::string > write_file()
+        {
+            geode::Logger::info( "[VOOutput::write] Writing vo file." );
+            find_properties();
+            file_ << "GOCAD Voxet 1" << EOL;
+            geode::internal::HeaderData header;
+            if( const auto name = grid_.name() )
+            {
+                header.name = geode::to_string( name.value() );
+            }
+            geode::internal::write_header( file_, header );
+            geode::internal::write_CRS( file_, {} );
+            write_axes();
+            write_properties_header();
+            file_ << "END" << EOL;
+            write_property_files();
+            std::vector< std::string > files{ geode::to_string( filename_ ) };
+            for( const auto& property : properties_ )
+            {
+                files.push_back( absl::StrCat( folder_, property.file ) );
+            }
+            return files;
+        }
+
+    private:
+        // Attributes with several items, such as vectors, are written as
+        // one property per item
+        void find_properties()
+        {
+            const auto& manager = grid_.cell_attribute_manager();
+            const auto prefix =
+                geode::filename_without_extension( filename_ ).string();
+            for( const auto& name : manager.attribute_names() )
+            {
+                auto attribute = manager.find_generic_attribute( name );
+                if( !attribute || !attribute->is_genericable() )
+                {
+                    continue;
+                }
+                const auto nb_items = attribute->nb_items();
+                for( const auto item : geode::LRange{ nb_items } )
+                {
+                    auto property = property_name(
+                        nb_items == 1 ? geode::to_string( name )
+                                      : absl::StrCat( name, "_", item ) );
+                    auto file = absl::StrCat( prefix, "_", property, "@@" );
+                    properties_.push_back( { attribute, item,
+                        std::move( property ), std::move( file ) } );
+                }
+            }
+        }
+
+        // Header records are split on spaces and property names are also
+        // used in file names: other characters than letters, digits, '_',
+        // '-' and '.' are replaced by '_', and a suffix is added to names
+        // already used
+        std::string property_name( std::string_view name ) const
+        {
+            std::string result{ name };
+            for( auto& character : result )
+            {
+                if( !absl::ascii_isalnum(
+                        static_cast< unsigned char >( character ) )
+                    && character != '_' && character != '-'
+                    && character != '.' )
+                {
+                    character = '_';
+                }
+            }
+            if( result.empty() )
+            {
+                result = "property";
+            }
+            const auto base = result;
+            const auto is_used = [this]( std::string_view candidate ) {
+                return absl::c_any_of(
+                    properties_, [candidate]( const Property& property ) {
+                        return property.name == candidate;
+                    } );
+            };
+            for( geode::index_t suffix = 1; is_used( result ); suffix++ )
+            {
+                result = absl::StrCat( base, "_", suffix );
+            }
+            if( result != name )
+            {
+                geode::Logger::warn( "[VOOutput::write] Attribute \"", name,
+                    "\" written as property ", result );
+            }
+            return result;
+        }
+
+        // Voxet axes are vectors spanning the whole grid, along the grid
+        // directions
+        void write_axes()
+        {
+            const auto& coordinate_system = grid_.grid_coordinate_system();
+            const auto& origin = coordinate_system.origin();
+            file_ << "AXIS_O " << origin.value( 0 ) << SPACE
+                  << origin.value( 1 ) << SPACE << origin.value( 2 ) << EOL;
+            const std::array< std::string_view, 3 > axes{ "AXIS_U", "AXIS_V",
+                "AXIS_W" };
+            for( const auto axis_id : geode::LRange{ 3 } )
+            {
+                const auto axis = coordinate_system.direction( axis_id )
+                                  * grid_.nb_cells_in_direction( axis_id );
+                file_ << axes[axis_id];
+                for( const auto d : geode::LRange{ 3 } )
+                {
+                    file_ << SPACE << axis.value( d );
+                }
+                file_ << EOL;
+            }
+            file_ << "AXIS_MIN 0 0 0" << EOL << "AXIS_MAX 1 1 1" << EOL;
+            file_ << "AXIS_N " << grid_.nb_cells_in_direction( 0 ) << SPACE
+                  << grid_.nb_cells_in_direction( 1 ) << SPACE
+                  << grid_.nb_cells_in_direction( 2 ) << EOL;
+            file_ << "AXIS_TYPE even even even" << EOL << EOL;
+        }
+
+        void write_properties_header()
+        {
+            for( const auto property : geode::Indices{ properties_ } )
+            {
+                const auto id = property + 1;
+                file_ << "PROPERTY " << id << SPACE
+                      << properties_[property].name << EOL;
+                file_ << "PROPERTY_KIND " << id << " \"Real Number\"" << EOL;
+                file_ << "PROP_ESIZE " << id << SPACE << ELEMENT_SIZE << EOL;
+                file_ << "PROP_ETYPE " << id << " IEEE" << EOL;
+                file_ << "PROP_FORMAT " << id << " RAW" << EOL;
+                file_ << "PROP_NO_DATA_VALUE " << id << SPACE << NO_DATA_VALUE
+                      << EOL;
+                file_ << "PROP_FILE " << id << SPACE
+                      << properties_[property].file << EOL << EOL;
+            }
+        }
+
+        void write_property_files() const
+        {
+            async::parallel_for(
+                async::irange( std::size_t{ 0 }, properties_.size() ),
+                [this]( std::size_t property ) {
+                    write_property_file( properties_[property] );
+                } );
+        }
+
+        // Cells are written in the grid cell order, u varying first then v
+        // and w. Each chunk is encoded in parallel blocks, then written.
+        void write_property_file( const Property& property ) const
+        {
+            const auto path = absl::StrCat( folder_, property.file );
+            const auto& attribute = *property.attribute;
+            std::ofstream file{ path, std::ios::binary };
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                file.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+                "Error while opening file: ", path );
+            const auto nb_cells = grid_.nb_cells();
+            std::vector< char > buffer(
+                std::size_t{ std::min( PROPERTY_CHUNK_SIZE, nb_cells ) }
+                * ELEMENT_SIZE );
+            for( geode::index_t first_cell = 0; first_cell < nb_cells;
+                 first_cell += std::min( PROPERTY_CHUNK_SIZE,
+                     nb_cells - first_cell ) )
+            {
+                const auto nb_values =
+                    std::min( PROPERTY_CHUNK_SIZE, nb_cells - first_cell );
+                const auto nb_blocks =
+                    ( nb_values + ENCODE_BLOCK_SIZE - 1 ) / ENCODE_BLOCK_SIZE;
+                async::parallel_for(
+                    async::irange( geode::index_t{ 0 }, nb_blocks ),
+                    [&]( geode::index_t block ) {
+                        const auto first_value = block * ENCODE_BLOCK_SIZE;
+                        const auto last_value = std::min(
+                            first_value + ENCODE_BLOCK_SIZE, nb_values );
+                        for( const auto value :
+                            geode::Range{ first_value, last_value } )
+                        {
+                            encode_value(
+                                attribute.generic_item_value(
+                                    first_cell + value, property.item ),
+                                buffer.data()
+                                    + std::size_t{ value } * ELEMENT_SIZE );
+                        }
+                    } );
+                file.write( buffer.data(),
+                    static_cast< std::streamsize >(
+                        std::size_t{ nb_values } * ELEMENT_SIZE ) );
+            }
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                file.good(), nullptr, geode::OpenGeodeException::TYPE::data,
+                "Error while writing file: ", path );
+        }
+
+        std::string_view filename_;
+        std::string folder_;
+        std::ofstream file_;
+        const geode::RegularGrid3D& grid_;
+        std::vector< Property > properties_;
+    };
+} // namespace
+
+namespace geode
+{
+    namespace internal
+    {
+        std::vector< std::string > VOOutput::write(
+            const RegularGrid3D& grid ) const
+        {
+            VOOutputImpl impl{ filename(), grid };
+            return impl.write_file();
+        }
+    } // namespace internal
+} // namespace geode
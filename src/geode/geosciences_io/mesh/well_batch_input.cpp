@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include <geode/geosciences_io/mesh/internal/well_batch_input.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+#include <typeinfo>
+
+#include <async++.h>
+
+#include <absl/container/btree_set.h>
+#include <absl/strings/ascii.h>
+
+#include <geode/basic/attribute_manager.hpp>
+#include <geode/basic/filename.hpp>
+#include <geode/basic/variable_attribute.hpp>
+
+#include <geode/mesh/builder/edged_curve_builder.hpp>
+#include <geode/mesh/core/edged_curve.hpp>
+#include <geode/mesh/core/mesh_factory.hpp>
+
+#include <geode/geosciences_io/mesh/internal/well_dat_input.hpp>
+#include <geode/geosciences_io/mesh/internal/well_dev_input.hpp>
+#include <geode/geosciences_io/mesh/internal/well_txt_input.hpp>
+#include <geode/geosciences_io/mesh/internal/wl_input.hpp>
+
+namespace
+{
+    std::string well_extension( std::string_view filename )
+    {
+        return absl::AsciiStrToLower(
+            geode::extension_from_filename( filename ) );
+    }
+
+    bool is_well_file( std::string_view filename )
+    {
+        const auto extension = well_extension( filename );
+        return extension == geode::internal::WLInput::extension()
+               || extension == geode::internal::WellDevInput::extension()
+               || extension == geode::internal::WellTxtInput::extension()
+               || extension == geode::internal::WellDatInput::extension();
+    }
+
+    // Calls the reader matching the extension directly, skipping the factory
+    // lookup and the is_loadable checks done by load_edged_curve
+    std::unique_ptr< geode::EdgedCurve3D > read_well(
+        std::string_view filename, const geode::MeshImpl& impl )
+    {
+        const auto extension = well_extension( filename );
+        if( extension == geode::internal::WLInput::extension() )
+        {
+            return geode::internal::WLInput{ filename }.read( impl );
+        }
+        if( extension == geode::internal::WellDevInput::extension() )
+        {
+            return geode::internal::WellDevInput{ filename }.read( impl );
+        }
+        if( extension == geode::internal::WellTxtInput::extension() )
+        {
+            return geode::internal::WellTxtInput{ filename }.read( impl );
+        }
+        if( extension == geode::internal::WellDatInput::extension() )
+        {
+            return geode::internal::WellDatInput{ filename }.read( impl );
+        }
+        throw geode::OpenGeodeGeosciencesIOMeshException{ nullptr,
+            geode::OpenGeodeException::TYPE::data,
+            "[load_wells] Unknown well file extension: ", filename };
+    }
+
+    bool is_double_attribute(
+        const geode::AttributeManager& manager, std::string_view name )
+    {
+        return manager.attribute_type( name ) == typeid( double ).name();
+    }
+
+    class PackedWellsBuilder
+    {
+    public:
+        PackedWellsBuilder(
+            absl::Span< const std::unique_ptr< geode::EdgedCurve3D > > wells,
+            absl::Span< const std::string > filenames )
+            : wells_( wells ), filenames_( filenames )
+        {
+            packed_.curve = geode::EdgedCurve3D::create();
+            builder_ = geode::EdgedCurveBuilder3D::create( *packed_.curve );
+        }
+
+        geode::internal::PackedWells build()
+        {
+            compute_offsets();
+            create_vertices();
+            create_edges();
+            create_well_ids();
+            copy_attributes();
+            return std::move( packed_ );
+        }
+
+    private:
+        void compute_offsets()
+        {
+            packed_.vertex_offsets.resize( wells_.size() + 1, 0 );
+            packed_.edge_offsets.resize( wells_.size() + 1, 0 );
+            packed_.names.reserve( wells_.size() );
+            for( const auto w : geode::Indices{ wells_ } )
+            {
+                packed_.vertex_offsets[w + 1] =
+                    packed_.vertex_offsets[w] + wells_[w]->nb_vertices();
+                packed_.edge_offsets[w + 1] =
+                    packed_.edge_offsets[w] + wells_[w]->nb_edges();
+                const auto stem =
+                    geode::filename_without_extension( filenames_[w] )
+                        .string();
+                packed_.names.emplace_back(
+                    wells_[w]->name().value_or( stem ) );
+            }
+        }
+
+        // Points are set sequentially: the builder is not thread-safe
+        void create_vertices()
+        {
+            builder_->create_vertices( packed_.vertex_offsets.back() );
+            for( const auto w : geode::Indices{ wells_ } )
+            {
+                const auto& well = *wells_[w];
+                const auto offset = packed_.vertex_offsets[w];
+                for( const auto v : geode::Range{ well.nb_vertices() } )
+                {
+                    builder_->set_point( offset + v, well.point( v ) );
+                }
+            }
+        }
+
+        void create_edges()
+        {
+            for( const auto w : geode::Indices{ wells_ } )
+            {
+                const auto& well = *wells_[w];
+                const auto offset = packed_.vertex_offsets[w];
+                for( const auto e : geode::Range{ well.nb_edges() } )
+                {
+                    const auto& vertices = well.edge_vertices( e );
+                    builder_->create_edge(
+                        offset + vertices[0], offset + vertices[1] );
+                }
+            }
+        }
+
+        void create_well_ids()
+        {
+            auto vertex_ids =
+                packed_.curve->vertex_attribute_manager()
+                    .find_or_create_attribute< geode::VariableAttribute,
+                        geode::index_t >(
+                        geode::internal::PackedWells::WELL_ID_ATTRIBUTE_NAME,
+                        geode::NO_ID );
+            auto edge_ids =
+                packed_.curve->edge_attribute_manager()
+                    .find_or_create_attribute< geode::VariableAttribute,
+                        geode::index_t >(
+                        geode::internal::PackedWells::WELL_ID_ATTRIBUTE_NAME,
+                        geode::NO_ID );
+            async::parallel_for(
+                async::irange( std::size_t{ 0 }, wells_.size() ),
+                [&]( std::size_t w ) {
+                    const auto well = static_cast< geode::index_t >( w );
+                    for( const auto v : geode::Range{ packed_.vertex_offsets[w],
+                             packed_.vertex_offsets[w + 1] } )
+                    {
+                        vertex_ids->set_value( v, well );
+                    }
+                    for( const auto e : geode::Range{ packed_.edge_offsets[w],
+                             packed_.edge_offsets[w + 1] } )
+                    {
+                        edge_ids->set_value( e, well );
+                    }
+                } );
+        }
+
+        void copy_attributes()
+        {
+            absl::btree_set< std::string > names;
+            for( const auto& well : wells_ )
+            {
+                const auto& manager = well->vertex_attribute_manager();
+                for( const auto& name : manager.attribute_names() )
+                {
+                    if( is_double_attribute( manager, name ) )
+                    {
+                        names.emplace( name );
+                    }
+                }
+            }
+            for( const auto& name : names )
+            {
+                copy_attribute( name );
+            }
+        }
+
+        void copy_attribute( std::string_view name )
+        {
+            auto attribute =
+                packed_.curve->vertex_attribute_manager()
+                    .find_or_create_attribute< geode::VariableAttribute,
+                        double >( name, 0 );
+            async::parallel_for(
+                async::irange( std::size_t{ 0 }, wells_.size() ),
+                [&]( std::size_t w ) {
+                    const auto& manager = wells_[w]->vertex_attribute_manager();
+                    if( !manager.attribute_exists( name )
+                        || !is_double_attribute( manager, name ) )
+                    {
+                        return;
+                    }
+                    const auto values =
+                        manager.find_attribute< double >( name );
+                    const auto offset = packed_.vertex_offsets[w];
+                    for( const auto v :
+                        geode::Range{ wells_[w]->nb_vertices() } )
+                    {
+                        attribute->set_value( offset + v, values->value( v ) );
+                    }
+                } );
+        }
+
+    private:
+        absl::Span< const std::unique_ptr< geode::EdgedCurve3D > > wells_;
+        absl::Span< const std::string > filenames_;
+        geode::internal::PackedWells packed_;
+        std::unique_ptr< geode::EdgedCurveBuilder3D > builder_;
+    };
+} // namespace
+
+namespace geode
+{
+    namespace internal
+    {
+        std::vector< std::string > well_files( std::string_view directory )
+        {
+            const std::filesystem::path path{ to_string( directory ) };
+            OpenGeodeGeosciencesIOMeshException::check_exception(
+                std::filesystem::is_directory( path ), nullptr,
+                OpenGeodeException::TYPE::data,
+                "[well_files] Cannot find directory ", directory );
+            std::vector< std::string > files;
+            for( const auto& entry :
+                std::filesystem::directory_iterator{ path } )
+            {
+                if( !entry.is_regular_file() )
+                {
+                    continue;
+                }
+                auto file = entry.path().string();
+                if( is_well_file( file ) )
+                {
+                    files.push_back( std::move( file ) );
+                }
+            }
+            std::sort( files.begin(), files.end() );
+            return files;
+        }
+
+        std::vector< std::unique_ptr< EdgedCurve3D > > load_wells(
+            absl::Span< const std::string > filenames )
+        {
+            const auto& impl =
+                MeshFactory::default_impl( EdgedCurve3D::type_name_static() );
+            std::vector< std::unique_ptr< EdgedCurve3D > > wells(
+                filenames.size() );
+            async::parallel_for(
+                async::irange( std::size_t{ 0 }, filenames.size() ),
+                [&]( std::size_t w ) {
+                    try
+                    {
+                        wells[w] = read_well( filenames[w], impl );
+                    }
+                    catch( const std::exception& exception )
+                    {
+                        throw OpenGeodeGeosciencesIOMeshException{ nullptr,
+                            OpenGeodeException::TYPE::data,
+                            "[load_wells] Cannot read well file ",
+                            filenames[w], ": ", exception.what() };
+                    }
+                } );
+            return wells;
+        }
+
+        PackedWells load_packed_wells(
+            absl::Span< const std::string > filenames )
+        {
+            const auto wells = load_wells( filenames );
+            return PackedWellsBuilder{ wells, filenames }.build();
+        }
+    } // namespace internal
+} // namespace geode
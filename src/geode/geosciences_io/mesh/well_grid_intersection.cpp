@@ -0,0 +1,862 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include <geode/geosciences_io/mesh/internal/well_grid_intersection.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <typeinfo>
+
+#include <async++.h>
+
+#include <geode/basic/attribute_manager.hpp>
+#include <geode/basic/range.hpp>
+
+#include <geode/geometry/coordinate_system.hpp>
+#include <geode/geometry/distance.hpp>
+#include <geode/geometry/point.hpp>
+#include <geode/geometry/vector.hpp>
+
+#include <geode/mesh/core/edged_curve.hpp>
+#include <geode/mesh/core/hybrid_solid.hpp>
+#include <geode/mesh/core/regular_grid_solid.hpp>
+
+#include <geode/geosciences_io/mesh/internal/corner_point_grid.hpp>
+
+namespace
+{
+    // Relative tolerance on the local coordinates of a point in a column
+    static constexpr double COLUMN_TOLERANCE = 1e-9;
+
+    static constexpr geode::index_t MAX_BISECTION_STEPS = 60;
+
+    // Offsets of the face neighbors of a cell, layers first
+    static constexpr std::array< std::array< int, 3 >, 6 > NEIGHBOR_OFFSETS{
+        { { 0, 0, 1 }, { 0, 0, -1 }, { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 },
+            { 0, -1, 0 } }
+    };
+
+    geode::Point3D segment_point(
+        const geode::Point3D& start, const geode::Point3D& end, double t )
+    {
+        return start * ( 1 - t ) + end * t;
+    }
+
+    // Measured depth of each well vertex
+    std::vector< double > measured_depths( const geode::EdgedCurve3D& well )
+    {
+        std::vector< double > depths( well.nb_vertices(), 0 );
+        const auto& manager = well.vertex_attribute_manager();
+        const auto name =
+            geode::internal::well_measured_depth_attribute_name();
+        if( manager.attribute_exists( name )
+            && manager.attribute_type( name ) == typeid( double ).name() )
+        {
+            const auto attribute = manager.find_attribute< double >( name );
+            for( const auto v : geode::Range{ well.nb_vertices() } )
+            {
+                depths[v] = attribute->value( v );
+            }
+            return depths;
+        }
+        for( const auto v : geode::Range{ 1, well.nb_vertices() } )
+        {
+            depths[v] = depths[v - 1]
+                        + geode::point_point_distance(
+                            well.point( v - 1 ), well.point( v ) );
+        }
+        return depths;
+    }
+
+    // Gathers the intersections of the successive well segments, merging
+    // contiguous parts in the same cell
+    class IntersectionCollector
+    {
+    public:
+        void add( geode::index_t cell,
+            double entry_depth,
+            double exit_depth,
+            double length )
+        {
+            if( length <= 0 )
+            {
+                return;
+            }
+            if( !intersections_.empty()
+                && intersections_.back().cell == cell
+                && intersections_.back().exit_depth == entry_depth )
+            {
+                auto& last = intersections_.back();
+                last.exit_depth = exit_depth;
+                last.length += length;
+                return;
+            }
+            intersections_.push_back(
+                { cell, entry_depth, exit_depth, length } );
+        }
+
+        std::vector< geode::internal::WellCellIntersection > release()
+        {
+            return std::move( intersections_ );
+        }
+
+    private:
+        std::vector< geode::internal::WellCellIntersection > intersections_;
+    };
+
+    // Amanatides and Woo traversal of the grid cells, in the grid coordinate
+    // system where cell (i,j,k) spans from (i,j,k) to (i+1,j+1,k+1)
+    class RegularGridTraversal
+    {
+    public:
+        RegularGridTraversal( const geode::RegularGrid3D& grid )
+            : grid_( grid ),
+              origin_( grid.grid_coordinate_system().origin() ),
+              nb_cells_{ grid.nb_cells_in_direction( 0 ),
+                  grid.nb_cells_in_direction( 1 ),
+                  grid.nb_cells_in_direction( 2 ) }
+        {
+            compute_inverse_directions( grid.grid_coordinate_system() );
+        }
+
+        std::vector< geode::internal::WellCellIntersection > traverse(
+            const geode::EdgedCurve3D& well ) const
+        {
+            IntersectionCollector collector;
+            if( well.nb_vertices() == 0 )
+            {
+                return collector.release();
+            }
+            const auto depths = measured_depths( well );
+            for( const auto v : geode::Range{ 1, well.nb_vertices() } )
+            {
+                traverse_segment( well.point( v - 1 ), well.point( v ),
+                    depths[v - 1], depths[v], collector );
+            }
+            return collector.release();
+        }
+
+    private:
+        // Rows of the inverse of the matrix whose columns are the grid
+        // directions, i.e. the cell vectors
+        void compute_inverse_directions(
+            const geode::CoordinateSystem3D& coordinate_system )
+        {
+            const auto& u = coordinate_system.direction( 0 );
+            const auto& v = coordinate_system.direction( 1 );
+            const auto& w = coordinate_system.direction( 2 );
+            const auto determinant = u.dot( v.cross( w ) );
+            geode::OpenGeodeGeosciencesIOMeshException::check_exception(
+                determinant != 0, nullptr,
+                geode::OpenGeodeException::TYPE::data,
+                "[well_cell_intersections] Degenerated grid directions" );
+            inverse_directions_ = { v.cross( w ) / determinant,
+                w.cross( u ) / determinant, u.cross( v ) / determinant };
+        }
+
+        geode::Point3D grid_coordinates( const geode::Point3D& point ) const
+        {
+            const geode::Vector3D vector{ origin_, point };
+            return geode::Point3D{ { inverse_directions_[0].dot( vector ),
+                inverse_directions_[1].dot( vector ),
+                inverse_directions_[2].dot( vector ) } };
+        }
+
+        void traverse_segment( const geode::Point3D& start,
+            const geode::Point3D& end,
+            double start_depth,
+            double end_depth,
+            IntersectionCollector& collector ) const
+        {
+            const auto length = geode::point_point_distance( start, end );
+            if( length == 0 )
+            {
+                return;
+            }
+            const auto from = grid_coordinates( start );
+            const auto to = grid_coordinates( end );
+            std::array< double, 3 > delta;
+            auto t_min = 0.;
+            auto t_max = 1.;
+            for( const auto d : geode::LRange{ 3 } )
+            {
+                delta[d] = to.value( d ) - from.value( d );
+                if( delta[d] == 0 )
+                {
+                    if( from.value( d ) < 0 || from.value( d ) > nb_cells_[d] )
+                    {
+                        return;
+                    }
+                    continue;
+                }
+                auto t0 = -from.value( d ) / delta[d];
+                auto t1 = ( nb_cells_[d] - from.value( d ) ) / delta[d];
+                if( t0 > t1 )
+                {
+                    std::swap( t0, t1 );
+                }
+                t_min = std::max( t_min, t0 );
+                t_max = std::min( t_max, t1 );
+            }
+            if( t_min >= t_max )
+            {
+                return;
+            }
+            std::array< geode::index_t, 3 > cell;
+            std::array< double, 3 > t_next;
+            std::array< double, 3 > t_delta;
+            for( const auto d : geode::LRange{ 3 } )
+            {
+                const auto coordinate = from.value( d ) + delta[d] * t_min;
+                cell[d] = static_cast< geode::index_t >(
+                    std::clamp( std::floor( coordinate ), 0.,
+                        static_cast< double >( nb_cells_[d] - 1 ) ) );
+                if( delta[d] == 0 )
+                {
+                    t_next[d] = std::numeric_limits< double >::max();
+                    t_delta[d] = std::numeric_limits< double >::max();
+                    continue;
+                }
+                const auto boundary = delta[d] > 0 ? cell[d] + 1. : cell[d];
+                t_next[d] = ( boundary - from.value( d ) ) / delta[d];
+                t_delta[d] = 1. / std::fabs( delta[d] );
+            }
+            const auto depth = [start_depth, end_depth]( double t ) {
+                return start_depth + ( end_depth - start_depth ) * t;
+            };
+            auto t = t_min;
+            while( true )
+            {
+                const auto d = static_cast< geode::local_index_t >(
+                    std::min_element( t_next.begin(), t_next.end() )
+                    - t_next.begin() );
+                const auto t_exit = std::min( t_next[d], t_max );
+                collector.add( grid_.cell_index( cell ), depth( t ),
+                    depth( t_exit ), ( t_exit - t ) * length );
+                if( t_exit >= t_max )
+                {
+                    return;
+                }
+                t = t_exit;
+                if( delta[d] > 0 )
+                {
+                    if( ++cell[d] == nb_cells_[d] )
+                    {
+                        return;
+                    }
+                }
+                else
+                {
+                    if( cell[d]-- == 0 )
+                    {
+                        return;
+                    }
+                }
+                t_next[d] += t_delta[d];
+            }
+        }
+
+    private:
+        const geode::RegularGrid3D& grid_;
+        geode::Point3D origin_;
+        std::array< geode::Vector3D, 3 > inverse_directions_;
+        std::array< geode::index_t, 3 > nb_cells_;
+    };
+
+    using ColumnCoordinates = std::array< double, 2 >;
+
+    // Local coordinates (u,v) of the point p in the quadrangle
+    // q[0] (0,0), q[1] (1,0), q[2] (1,1), q[3] (0,1), by Newton iterations
+    std::optional< ColumnCoordinates > inverse_bilinear(
+        const std::array< std::array< double, 2 >, 4 >& q,
+        const std::array< double, 2 >& p )
+    {
+        ColumnCoordinates uv{ 0.5, 0.5 };
+        for( [[maybe_unused]] const auto iteration : geode::Range{ 20 } )
+        {
+            const auto [u, v] = uv;
+            std::array< double, 2 > residual;
+            std::array< double, 2 > du;
+            std::array< double, 2 > dv;
+            for( const auto d : geode::LRange{ 2 } )
+            {
+                residual[d] = ( 1 - u ) * ( 1 - v ) * q[0][d]
+                              + u * ( 1 - v ) * q[1][d] + u * v * q[2][d]
+                              + ( 1 - u ) * v * q[3][d] - p[d];
+                du[d] = ( 1 - v ) * ( q[1][d] - q[0][d] )
+                        + v * ( q[2][d] - q[3][d] );
+                dv[d] = ( 1 - u ) * ( q[3][d] - q[0][d] )
+                        + u * ( q[2][d] - q[1][d] );
+            }
+            const auto determinant = du[0] * dv[1] - du[1] * dv[0];
+            if( determinant == 0 )
+            {
+                return std::nullopt;
+            }
+            const auto step_u =
+                ( residual[0] * dv[1] - residual[1] * dv[0] ) / determinant;
+            const auto step_v =
+                ( du[0] * residual[1] - du[1] * residual[0] ) / determinant;
+            uv[0] -= step_u;
+            uv[1] -= step_v;
+            if( std::fabs( step_u ) + std::fabs( step_v ) < 1e-12 )
+            {
+                break;
+            }
+        }
+        return uv;
+    }
+
+    double bilinear( const std::array< double, 4 >& values,
+        const ColumnCoordinates& uv )
+    {
+        const auto [u, v] = uv;
+        return ( 1 - u ) * ( 1 - v ) * values[0] + u * ( 1 - v ) * values[1]
+               + u * v * values[2] + ( 1 - u ) * v * values[3];
+    }
+
+    // Walk through a corner-point grid: columns are located from the pillar
+    // positions at the point depth, then layers from the ZCORN depths.
+    class CornerPointGridTraversal
+    {
+        struct Location
+        {
+            geode::index_t cell;
+            std::array< geode::index_t, 3 > grid_coordinates;
+        };
+
+    public:
+        CornerPointGridTraversal( const geode::internal::CornerPointGrid& grid )
+            : grid_( grid ),
+              nb_cells_{ grid.nb_cells_in_direction( 0 ),
+                  grid.nb_cells_in_direction( 1 ),
+                  grid.nb_cells_in_direction( 2 ) },
+              pillars_( grid.pillar_coordinates() ),
+              depths_( grid.corner_depths() )
+        {
+            compute_bounds();
+        }
+
+        std::vector< geode::internal::WellCellIntersection > traverse(
+            const geode::EdgedCurve3D& well ) const
+        {
+            IntersectionCollector collector;
+            if( well.nb_vertices() == 0 || grid_.nb_cells() == 0 )
+            {
+                return collector.release();
+            }
+            const auto depths = measured_depths( well );
+            std::optional< Location > hint;
+            for( const auto v : geode::Range{ 1, well.nb_vertices() } )
+            {
+                traverse_segment( well.point( v - 1 ), well.point( v ),
+                    depths[v - 1], depths[v], hint, collector );
+            }
+            return collector.release();
+        }
+
+    private:
+        void compute_bounds()
+        {
+            min_depth_ = std::numeric_limits< double >::max();
+            max_depth_ = std::numeric_limits< double >::lowest();
+            for( const auto depth : depths_ )
+            {
+                min_depth_ = std::min( min_depth_, depth );
+                max_depth_ = std::max( max_depth_, depth );
+            }
+            std::array< double, 2 > min{ std::numeric_limits< double >::max(),
+                std::numeric_limits< double >::max() };
+            std::array< double, 2 > max{
+                std::numeric_limits< double >::lowest(),
+                std::numeric_limits< double >::lowest()
+            };
+            for( const auto pillar : geode::Range{ grid_.nb_pillars() } )
+            {
+                for( const auto d : geode::LRange{ 2 } )
+                {
+                    min[d] = std::min( min[d], pillars_[6 * pillar + d] );
+                    max[d] = std::max( max[d], pillars_[6 * pillar + d] );
+                }
+            }
+            step_ = ( max_depth_ - min_depth_ ) / nb_cells_[2];
+            for( const auto d : geode::LRange{ 2 } )
+            {
+                const auto size = ( max[d] - min[d] ) / nb_cells_[d];
+                if( size > 0 )
+                {
+                    step_ = std::min( step_, size );
+                }
+            }
+            // Outside the grid, the segments are sampled with this step:
+            // shorter pieces re-entering the grid, e.g. across a fault
+            // throw, may be missed
+            step_ = std::max( step_ / 4, geode::GLOBAL_EPSILON );
+        }
+
+        void traverse_segment( const geode::Point3D& start,
+            const geode::Point3D& end,
+            double start_depth,
+            double end_depth,
+            std::optional< Location >& hint,
+            IntersectionCollector& collector ) const
+        {
+            const auto length = geode::point_point_distance( start, end );
+            if( length == 0 )
+            {
+                return;
+            }
+            auto t_min = 0.;
+            auto t_max = 1.;
+            const auto dz = end.value( 2 ) - start.value( 2 );
+            if( dz != 0 )
+            {
+                auto t0 = ( min_depth_ - start.value( 2 ) ) / dz;
+                auto t1 = ( max_depth_ - start.value( 2 ) ) / dz;
+                if( t0 > t1 )
+                {
+                    std::swap( t0, t1 );
+                }
+                t_min = std::max( t_min, t0 );
+                t_max = std::min( t_max, t1 );
+            }
+            else if( start.value( 2 ) < min_depth_
+                     || start.value( 2 ) > max_depth_ )
+            {
+                return;
+            }
+            if( t_min >= t_max )
+            {
+                return;
+            }
+            const auto point = [&start, &end]( double t ) {
+                return segment_point( start, end, t );
+            };
+            const auto depth = [start_depth, end_depth]( double t ) {
+                return start_depth + ( end_depth - start_depth ) * t;
+            };
+            const auto t_step = step_ / length;
+            auto t = t_min;
+            auto current = locate( point( t ), hint );
+            while( t < t_max )
+            {
+                if( !current )
+                {
+                    // Outside the grid: move forward until the segment
+                    // enters a cell, then go back to the grid boundary
+                    const auto t_next = std::min( t + t_step, t_max );
+                    current = locate( point( t_next ), hint );
+                    if( current )
+                    {
+                        t = bisect(
+                            [&]( double t_middle ) {
+                                return locate( point( t_middle ), current )
+                                    .has_value();
+                            },
+                            t_next, t )
+                                .first;
+                        current = locate( point( t ), current );
+                    }
+                    else
+                    {
+                        t = t_next;
+                    }
+                    continue;
+                }
+                hint = current;
+                const auto cell = current.value();
+                auto t_exit = t_max;
+                if( !contains( cell, point( t_max ) ) )
+                {
+                    t_exit = bisect(
+                        [&]( double t_middle ) {
+                            return contains( cell, point( t_middle ) );
+                        },
+                        t, t_max )
+                                 .second;
+                }
+                if( grid_.is_cell_active( cell.cell ) )
+                {
+                    collector.add( cell.cell, depth( t ), depth( t_exit ),
+                        ( t_exit - t ) * length );
+                }
+                if( t_exit >= t_max )
+                {
+                    return;
+                }
+                t = t_exit;
+                current = locate( point( t ), hint );
+            }
+        }
+
+        // Parameters on both sides of the boundary of the region where the
+        // predicate holds, between t_inside and t_outside
+        template < typename Predicate >
+        static std::pair< double, double > bisect( const Predicate& is_inside,
+            double t_inside,
+            double t_outside )
+        {
+            for( [[maybe_unused]] const auto step :
+                geode::Range{ MAX_BISECTION_STEPS } )
+            {
+                const auto t_middle = ( t_inside + t_outside ) / 2;
+                if( t_middle == t_inside || t_middle == t_outside )
+                {
+                    break;
+                }
+                if( is_inside( t_middle ) )
+                {
+                    t_inside = t_middle;
+                }
+                else
+                {
+                    t_outside = t_middle;
+                }
+            }
+            return { t_inside, t_outside };
+        }
+
+        std::optional< Location > locate( const geode::Point3D& point,
+            const std::optional< Location >& hint ) const
+        {
+            if( hint )
+            {
+                for( const auto& offset : NEIGHBOR_OFFSETS )
+                {
+                    const auto location =
+                        neighbor_location( hint->grid_coordinates, offset );
+                    if( location && contains( location.value(), point ) )
+                    {
+                        return location;
+                    }
+                }
+            }
+            const auto column = locate_column(
+                point, hint ? std::array< geode::index_t, 2 >{
+                    hint->grid_coordinates[0], hint->grid_coordinates[1] }
+                            : std::array< geode::index_t, 2 >{
+                                nb_cells_[0] / 2, nb_cells_[1] / 2 } );
+            if( !column )
+            {
+                return std::nullopt;
+            }
+            return locate_layer( column->first, column->second, point,
+                hint ? hint->grid_coordinates[2] : 0 );
+        }
+
+        std::optional< Location > neighbor_location(
+            const std::array< geode::index_t, 3 >& grid_coordinates,
+            const std::array< int, 3 >& offset ) const
+        {
+            std::array< geode::index_t, 3 > neighbor;
+            for( const auto d : geode::LRange{ 3 } )
+            {
+                const auto coordinate =
+                    static_cast< int >( grid_coordinates[d] ) + offset[d];
+                if( coordinate < 0
+                    || coordinate >= static_cast< int >( nb_cells_[d] ) )
+                {
+                    return std::nullopt;
+                }
+                neighbor[d] = static_cast< geode::index_t >( coordinate );
+            }
+            return Location{ grid_.cell_index( neighbor ), neighbor };
+        }
+
+        // Walks from column to column following the local coordinates of the
+        // point, falling back to a scan of all the columns if the walk fails
+        std::optional< std::pair< std::array< geode::index_t, 2 >,
+            ColumnCoordinates > >
+            locate_column( const geode::Point3D& point,
+                std::array< geode::index_t, 2 > column ) const
+        {
+            for( [[maybe_unused]] const auto step :
+                geode::Range{ nb_cells_[0] + nb_cells_[1] + 2 } )
+            {
+                const auto uv = column_coordinates( column, point );
+                if( !uv )
+                {
+                    break;
+                }
+                std::array< geode::index_t, 2 > next = column;
+                for( const auto d : geode::LRange{ 2 } )
+                {
+                    if( uv.value()[d] < -COLUMN_TOLERANCE && column[d] > 0 )
+                    {
+                        next[d]--;
+                    }
+                    else if( uv.value()[d] > 1 + COLUMN_TOLERANCE
+                             && column[d] + 1 < nb_cells_[d] )
+                    {
+                        next[d]++;
+                    }
+                }
+                if( next == column )
+                {
+                    if( is_in_column( uv.value() ) )
+                    {
+                        return std::make_pair( column, uv.value() );
+                    }
+                    return std::nullopt;
+                }
+                column = next;
+            }
+            for( const auto j : geode::Range{ nb_cells_[1] } )
+            {
+                for( const auto i : geode::Range{ nb_cells_[0] } )
+                {
+                    const auto uv = column_coordinates( { i, j }, point );
+                    if( uv && is_in_column( uv.value() ) )
+                    {
+                        return std::make_pair(
+                            std::array< geode::index_t, 2 >{ i, j },
+                            uv.value() );
+                    }
+                }
+            }
+            return std::nullopt;
+        }
+
+        // Searches the layers from the hint one outwards
+        std::optional< Location > locate_layer(
+            const std::array< geode::index_t, 2 >& column,
+            const ColumnCoordinates& uv,
+            const geode::Point3D& point,
+            geode::index_t hint_layer ) const
+        {
+            const auto nz = static_cast< int >( nb_cells_[2] );
+            const auto first =
+                std::min( static_cast< int >( hint_layer ), nz - 1 );
+            const auto try_layer = [&]( int k ) -> std::optional< Location > {
+                if( k < 0 || k >= nz )
+                {
+                    return std::nullopt;
+                }
+                const std::array< geode::index_t, 3 > grid_coordinates{
+                    column[0], column[1], static_cast< geode::index_t >( k )
+                };
+                if( !is_in_layer( grid_coordinates, uv, point ) )
+                {
+                    return std::nullopt;
+                }
+                return Location{ grid_.cell_index( grid_coordinates ),
+                    grid_coordinates };
+            };
+            if( const auto location = try_layer( first ) )
+            {
+                return location;
+            }
+            for( const auto offset : geode::Range{ 1, nb_cells_[2] } )
+            {
+                const auto shift = static_cast< int >( offset );
+                if( first - shift < 0 && first + shift >= nz )
+                {
+                    break;
+                }
+                if( const auto location = try_layer( first + shift ) )
+                {
+                    return location;
+                }
+                if( const auto location = try_layer( first - shift ) )
+                {
+                    return location;
+                }
+            }
+            return std::nullopt;
+        }
+
+        bool contains(
+            const Location& location, const geode::Point3D& point ) const
+        {
+            const auto& grid_coordinates = location.grid_coordinates;
+            const auto uv = column_coordinates(
+                { grid_coordinates[0], grid_coordinates[1] }, point );
+            return uv && is_in_column( uv.value() )
+                   && is_in_layer( grid_coordinates, uv.value(), point );
+        }
+
+        static bool is_in_column( const ColumnCoordinates& uv )
+        {
+            return uv[0] >= -COLUMN_TOLERANCE && uv[0] <= 1 + COLUMN_TOLERANCE
+                   && uv[1] >= -COLUMN_TOLERANCE
+                   && uv[1] <= 1 + COLUMN_TOLERANCE;
+        }
+
+        // Local coordinates of the point in the column section at its depth
+        std::optional< ColumnCoordinates > column_coordinates(
+            const std::array< geode::index_t, 2 >& column,
+            const geode::Point3D& point ) const
+        {
+            const auto [i, j] = column;
+            const auto nx = nb_cells_[0] + 1;
+            const std::array< geode::index_t, 4 > pillars{ i + nx * j,
+                i + 1 + nx * j, i + 1 + nx * ( j + 1 ), i + nx * ( j + 1 ) };
+            std::array< std::array< double, 2 >, 4 > section;
+            for( const auto p : geode::LRange{ 4 } )
+            {
+                section[p] = pillar_position( pillars[p], point.value( 2 ) );
+            }
+            return inverse_bilinear(
+                section, { point.value( 0 ), point.value( 1 ) } );
+        }
+
+        std::array< double, 2 > pillar_position(
+            geode::index_t pillar, double depth ) const
+        {
+            const auto* coordinates = &pillars_[6 * pillar];
+            const auto height = coordinates[5] - coordinates[2];
+            const auto lambda =
+                height == 0 ? 0. : ( depth - coordinates[2] ) / height;
+            return { coordinates[0]
+                         + lambda * ( coordinates[3] - coordinates[0] ),
+                coordinates[1] + lambda * ( coordinates[4] - coordinates[1] ) };
+        }
+
+        bool is_in_layer(
+            const std::array< geode::index_t, 3 >& grid_coordinates,
+            const ColumnCoordinates& uv,
+            const geode::Point3D& point ) const
+        {
+            const auto top =
+                bilinear( layer_depths( grid_coordinates, 0 ), uv );
+            const auto bottom =
+                bilinear( layer_depths( grid_coordinates, 1 ), uv );
+            const auto depth = point.value( 2 );
+            return depth >= std::min( top, bottom ) - geode::GLOBAL_EPSILON
+                   && depth <= std::max( top, bottom ) + geode::GLOBAL_EPSILON
+                   && top != bottom;
+        }
+
+        // Depths of the cell top (0) or bottom (1) corners, in the
+        // inverse_bilinear order, as laid out in the ZCORN keyword
+        std::array< double, 4 > layer_depths(
+            const std::array< geode::index_t, 3 >& grid_coordinates,
+            geode::index_t side ) const
+        {
+            const auto [i, j, k] = grid_coordinates;
+            const auto nx = nb_cells_[0];
+            const auto layer =
+                std::size_t{ 4 } * nx * nb_cells_[1] * ( 2 * k + side );
+            const auto corner = [&]( geode::index_t di, geode::index_t dj ) {
+                return depths_[layer + 2 * i + di
+                               + std::size_t{ 2 } * nx * ( 2 * j + dj )];
+            };
+            return { corner( 0, 0 ), corner( 1, 0 ), corner( 1, 1 ),
+                corner( 0, 1 ) };
+        }
+
+    private:
+        const geode::internal::CornerPointGrid& grid_;
+        std::array< geode::index_t, 3 > nb_cells_;
+        absl::Span< const double > pillars_;
+        absl::Span< const double > depths_;
+        double min_depth_;
+        double max_depth_;
+        double step_;
+    };
+
+    template < typename Traversal >
+    std::vector< std::vector< geode::internal::WellCellIntersection > >
+        traverse_wells( const Traversal& traversal,
+            absl::Span< const std::unique_ptr< geode::EdgedCurve3D > > wells )
+    {
+        std::vector< std::vector< geode::internal::WellCellIntersection > >
+            intersections( wells.size() );
+        async::parallel_for( async::irange( std::size_t{ 0 }, wells.size() ),
+            [&]( std::size_t w ) {
+                intersections[w] = traversal.traverse( *wells[w] );
+            } );
+        return intersections;
+    }
+
+    // Polyhedron of each corner-point grid cell, NO_ID if missing
+    std::vector< geode::index_t > cell_polyhedra(
+        const geode::HybridSolid3D& solid,
+        const geode::internal::CornerPointGrid& grid )
+    {
+        std::vector< geode::index_t > polyhedra(
+            grid.nb_cells(), geode::NO_ID );
+        const auto grid_coordinates =
+            solid.polyhedron_attribute_manager()
+                .find_attribute< std::array< geode::index_t, 3 > >(
+                    geode::internal::CornerPointGrid::
+                        grid_coordinates_attribute_name() );
+        for( const auto polyhedron : geode::Range{ solid.nb_polyhedra() } )
+        {
+            const auto cell =
+                grid.cell_index( grid_coordinates->value( polyhedron ) );
+            polyhedra[cell] = polyhedron;
+        }
+        return polyhedra;
+    }
+} // namespace
+
+namespace geode
+{
+    namespace internal
+    {
+        std::vector< WellCellIntersection > well_cell_intersections(
+            const RegularGrid3D& grid, const EdgedCurve3D& well )
+        {
+            return RegularGridTraversal{ grid }.traverse( well );
+        }
+
+        std::vector< WellCellIntersection > well_cell_intersections(
+            const CornerPointGrid& grid, const EdgedCurve3D& well )
+        {
+            return CornerPointGridTraversal{ grid }.traverse( well );
+        }
+
+        std::vector< std::vector< WellCellIntersection > >
+            wells_cell_intersections( const RegularGrid3D& grid,
+                absl::Span< const std::unique_ptr< EdgedCurve3D > > wells )
+        {
+            return traverse_wells( RegularGridTraversal{ grid }, wells );
+        }
+
+        std::vector< std::vector< WellCellIntersection > >
+            wells_cell_intersections( const CornerPointGrid& grid,
+                absl::Span< const std::unique_ptr< EdgedCurve3D > > wells )
+        {
+            return traverse_wells( CornerPointGridTraversal{ grid }, wells );
+        }
+
+        std::vector< std::vector< WellCellIntersection > >
+            wells_cell_intersections( const HybridSolid3D& solid,
+                absl::Span< const std::unique_ptr< EdgedCurve3D > > wells )
+        {
+            const auto grid = corner_point_grid_from_hybrid_solid( solid );
+            auto intersections = wells_cell_intersections( grid, wells );
+            const auto polyhedra = cell_polyhedra( solid, grid );
+            for( auto& well_intersections : intersections )
+            {
+                for( auto& intersection : well_intersections )
+                {
+                    intersection.cell = polyhedra[intersection.cell];
+                }
+            }
+            return intersections;
+        }
+    } // namespace internal
+} // namespace geode
@@ -23,8 +23,6 @@
 
 #include <geode/geosciences_io/model/common.hpp>
 
-#include <gdal_priv.h>
-
 #include <geode/mesh/io/regular_grid_input.hpp>
 #include <geode/mesh/io/triangulated_surface_input.hpp>
 
@@ -108,6 +106,5 @@ namespace geode
         register_section_input();
         register_brep_output();
         register_horizons_stack_input();
-        GDALAllRegister();
     }
 } // namespace geode
@@ -276,6 +276,8 @@ namespace geode
         Section SHPInput::read()
         {
             Section section;
+            register_gdal_drivers();
+            const ScopedGDALConfiguration gdal_scope{ options_.gdal };
             SHPInputImpl impl{ section, filename() };
             impl.read_file();
             return section;
@@ -293,6 +295,7 @@ namespace geode
 
         Percentage SHPInput::is_loadable() const
         {
+            register_gdal_drivers();
             detail::GDALFile reader{ filename() };
             if( reader.dataset().GetLayerCount() == 0 )
             {
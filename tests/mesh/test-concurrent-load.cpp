@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/tests_config.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <absl/algorithm/container.h>
+
+#include <geode/basic/assert.hpp>
+#include <geode/basic/attribute_manager.hpp>
+#include <geode/basic/logger.hpp>
+#include <geode/basic/range.hpp>
+
+#include <geode/mesh/core/edged_curve.hpp>
+#include <geode/mesh/core/light_regular_grid.hpp>
+#include <geode/mesh/core/point_set.hpp>
+#include <geode/mesh/core/polygonal_surface.hpp>
+#include <geode/mesh/core/regular_grid_solid.hpp>
+#include <geode/mesh/core/triangulated_surface.hpp>
+#include <geode/mesh/io/edged_curve_input.hpp>
+#include <geode/mesh/io/light_regular_grid_input.hpp>
+#include <geode/mesh/io/point_set_input.hpp>
+#include <geode/mesh/io/polygonal_surface_input.hpp>
+#include <geode/mesh/io/regular_grid_input.hpp>
+#include <geode/mesh/io/triangulated_surface_input.hpp>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/geotiff_input.hpp>
+
+namespace
+{
+    // What a load produced: two loads of the same file give equal results
+    struct LoadResult
+    {
+        bool operator==( const LoadResult& other ) const
+        {
+            return nb_elements == other.nb_elements
+                   && geometry_checksum == other.geometry_checksum
+                   && attributes_checksum == other.attributes_checksum;
+        }
+
+        bool operator!=( const LoadResult& other ) const
+        {
+            return !( *this == other );
+        }
+
+        geode::index_t nb_elements{ 0 };
+        double geometry_checksum{ 0 };
+        double attributes_checksum{ 0 };
+    };
+
+    // Values are weighted by their element, so that permuted values change
+    // the checksum
+    template < typename Mesh >
+    double points_checksum( const Mesh& mesh )
+    {
+        double checksum{ 0 };
+        for( const auto vertex : geode::Range{ mesh.nb_vertices() } )
+        {
+            const auto& point = mesh.point( vertex );
+            for( const auto d : geode::LRange{ Mesh::dim } )
+            {
+                checksum += ( vertex + 1. ) * ( d + 1. ) * point.value( d );
+            }
+        }
+        return checksum;
+    }
+
+    template < typename Grid >
+    double grid_checksum( const Grid& grid )
+    {
+        double checksum{ 0 };
+        for( const auto d : geode::LRange{ Grid::dim } )
+        {
+            checksum += ( d + 1. )
+                        * ( grid.origin().value( d )
+                            + grid.cell_length_in_direction( d ) );
+        }
+        return checksum;
+    }
+
+    double attributes_checksum( const geode::AttributeManager& manager )
+    {
+        auto names = manager.attribute_names();
+        absl::c_sort( names );
+        double checksum{ 0 };
+        for( const auto& name : names )
+        {
+            const auto attribute = manager.find_generic_attribute( name );
+            if( !attribute || !attribute->is_genericable() )
+            {
+                continue;
+            }
+            for( const auto element : geode::Range{ manager.nb_elements() } )
+            {
+                for( const auto item :
+                    geode::LRange{ attribute->nb_items() } )
+                {
+                    checksum += ( element + 1. )
+                                * attribute->generic_item_value(
+                                    element, item );
+                }
+            }
+        }
+        return checksum;
+    }
+
+    template < typename Mesh >
+    LoadResult mesh_result( const Mesh& mesh, geode::index_t nb_elements )
+    {
+        return { nb_elements, points_checksum( mesh ),
+            attributes_checksum( mesh.vertex_attribute_manager() ) };
+    }
+
+    template < typename Grid >
+    LoadResult grid_result( const Grid& grid )
+    {
+        return { grid.nb_cells(), grid_checksum( grid ),
+            attributes_checksum( grid.cell_attribute_manager() ) };
+    }
+
+    // Each loader reads one file and returns what it produced
+    using Loader = std::function< LoadResult() >;
+
+    std::vector< Loader > create_loaders()
+    {
+        const auto tiff = absl::StrCat( geode::DATA_PATH, "cea.tiff" );
+        return {
+            [tiff] {
+                return grid_result(
+                    geode::load_light_regular_grid< 2 >( tiff ) );
+            },
+            [tiff] {
+                geode::internal::GEOTIFFInputOptions options;
+                options.window.cells = { { { 10, 20 }, { 110, 70 } } };
+                options.band_attributes = true;
+                return grid_result(
+                    geode::internal::GEOTIFFInput{ tiff, options }.read() );
+            },
+            [tiff] {
+                const auto surface =
+                    geode::load_polygonal_surface< 3 >( tiff );
+                return mesh_result( *surface, surface->nb_polygons() );
+            },
+            [] {
+                const auto surface = geode::load_triangulated_surface< 3 >(
+                    absl::StrCat( geode::DATA_PATH, "surf2d.ts" ) );
+                return mesh_result( *surface, surface->nb_polygons() );
+            },
+            [] {
+                const auto points = geode::load_point_set< 3 >(
+                    absl::StrCat( geode::DATA_PATH, "points.vs" ) );
+                return mesh_result( *points, points->nb_vertices() );
+            },
+            [] {
+                const auto curve = geode::load_edged_curve< 3 >(
+                    absl::StrCat( geode::DATA_PATH, "normal_lines.pl" ) );
+                return mesh_result( *curve, curve->nb_edges() );
+            },
+            [] {
+                return grid_result( *geode::load_regular_grid< 3 >(
+                    absl::StrCat( geode::DATA_PATH, "test_binary.vo" ) ) );
+            },
+        };
+    }
+
+    // Every thread loads all the files, starting from a different one, and
+    // checks that it gets the same elements, points and attribute values as
+    // a sequential load
+    void test_concurrent_load()
+    {
+        static constexpr geode::index_t NB_ROUNDS = 2;
+        const auto loaders = create_loaders();
+        std::vector< LoadResult > expected;
+        for( const auto& loader : loaders )
+        {
+            expected.push_back( loader() );
+        }
+        const auto nb_threads =
+            std::max( 4u, std::thread::hardware_concurrency() );
+        std::atomic< geode::index_t > nb_failures{ 0 };
+        std::vector< std::thread > threads;
+        for( const auto thread_id : geode::Range{ nb_threads } )
+        {
+            threads.emplace_back( [&, thread_id] {
+                for( const auto round : geode::Range{ NB_ROUNDS } )
+                {
+                    for( const auto l : geode::Indices{ loaders } )
+                    {
+                        const auto loader =
+                            ( l + thread_id + round ) % loaders.size();
+                        try
+                        {
+                            if( loaders[loader]() != expected[loader] )
+                            {
+                                nb_failures++;
+                            }
+                        }
+                        catch( ... )
+                        {
+                            nb_failures++;
+                        }
+                    }
+                }
+            } );
+        }
+        for( auto& thread : threads )
+        {
+            thread.join();
+        }
+        geode::OpenGeodeGeosciencesIOMeshException::test( nb_failures == 0,
+            "[TEST] ", nb_failures.load(), " concurrent loads failed" );
+    }
+} // namespace
+
+int main()
+{
+    try
+    {
+        geode::OpenGeodeGeosciencesIOMeshLibrary::initialize();
+        test_concurrent_load();
+
+        geode::Logger::info( "[TEST SUCCESS]" );
+
+        return 0;
+    }
+    catch( ... )
+    {
+        return geode::geode_lippincott();
+    }
+}
@@ -23,15 +23,314 @@
 
 #include <geode/tests_config.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <absl/algorithm/container.h>
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
 #include <geode/basic/assert.hpp>
 #include <geode/basic/logger.hpp>
+#include <geode/basic/range.hpp>
 
+#include <geode/geometry/point.hpp>
+
+#include <geode/mesh/core/geode/geode_triangulated_surface.hpp>
 #include <geode/mesh/core/polygonal_surface.hpp>
+#include <geode/mesh/core/triangulated_surface.hpp>
 
 #include <geode/mesh/io/polygonal_surface_input.hpp>
 #include <geode/mesh/io/polygonal_surface_output.hpp>
+#include <geode/mesh/io/triangulated_surface_input.hpp>
 
 #include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/dem_tin_input.hpp>
+
+// Points sorted in the buckets of a regular grid on their horizontal
+// bounding box
+class HorizontalBuckets
+{
+    static constexpr geode::index_t NB_BUCKETS{ 512 };
+
+public:
+    explicit HorizontalBuckets( std::vector< geode::Point3D > points )
+        : points_( std::move( points ) ),
+          buckets_( NB_BUCKETS * NB_BUCKETS )
+    {
+        for( const auto& point : points_ )
+        {
+            for( const auto d : geode::LRange{ 2 } )
+            {
+                min_[d] = std::min( min_[d], point.value( d ) );
+                max_[d] = std::max( max_[d], point.value( d ) );
+            }
+        }
+        for( const auto p : geode::Indices{ points_ } )
+        {
+            const auto bucket = bucket_coordinates(
+                { points_[p].value( 0 ), points_[p].value( 1 ) } );
+            buckets_[bucket[1] * NB_BUCKETS + bucket[0]].push_back( p );
+        }
+    }
+
+    geode::index_t nb_points() const
+    {
+        return static_cast< geode::index_t >( points_.size() );
+    }
+
+    const geode::Point3D& point( geode::index_t p ) const
+    {
+        return points_[p];
+    }
+
+    // Calls action( p ) for the points of the buckets intersecting the
+    // horizontal box
+    template < typename Action >
+    void for_each_point_near( const std::array< double, 2 >& box_min,
+        const std::array< double, 2 >& box_max,
+        Action&& action ) const
+    {
+        const auto first = bucket_coordinates( box_min );
+        const auto last = bucket_coordinates( box_max );
+        for( const auto j : geode::Range{ first[1], last[1] + 1 } )
+        {
+            for( const auto i : geode::Range{ first[0], last[0] + 1 } )
+            {
+                for( const auto p : buckets_[j * NB_BUCKETS + i] )
+                {
+                    action( p );
+                }
+            }
+        }
+    }
+
+private:
+    std::array< geode::index_t, 2 > bucket_coordinates(
+        const std::array< double, 2 >& coordinates ) const
+    {
+        std::array< geode::index_t, 2 > bucket;
+        for( const auto d : geode::LRange{ 2 } )
+        {
+            const auto extent = std::max( max_[d] - min_[d], 1e-30 );
+            const auto position =
+                ( coordinates[d] - min_[d] ) / extent * NB_BUCKETS;
+            bucket[d] = static_cast< geode::index_t >(
+                std::clamp( position, 0., NB_BUCKETS - 1. ) );
+        }
+        return bucket;
+    }
+
+private:
+    std::vector< geode::Point3D > points_;
+    std::array< double, 2 > min_{ { INFINITY, INFINITY } };
+    std::array< double, 2 > max_{ { -INFINITY, -INFINITY } };
+    std::vector< std::vector< geode::index_t > > buckets_;
+};
+
+std::array< geode::Point3D, 3 > triangle_points(
+    const geode::TriangulatedSurface3D& tin, geode::index_t triangle )
+{
+    return { tin.point( tin.polygon_vertex( { triangle, 0 } ) ),
+        tin.point( tin.polygon_vertex( { triangle, 1 } ) ),
+        tin.point( tin.polygon_vertex( { triangle, 2 } ) ) };
+}
+
+// Barycentric coordinates of the point projected in the horizontal plane,
+// if it lies inside the triangle
+std::optional< std::array< double, 3 > > horizontal_barycentric_coordinates(
+    const geode::Point3D& point,
+    const std::array< geode::Point3D, 3 >& triangle )
+{
+    const auto& a = triangle[0];
+    const auto& b = triangle[1];
+    const auto& c = triangle[2];
+    const auto determinant = ( b.value( 1 ) - c.value( 1 ) )
+                                 * ( a.value( 0 ) - c.value( 0 ) )
+                             + ( c.value( 0 ) - b.value( 0 ) )
+                                   * ( a.value( 1 ) - c.value( 1 ) );
+    if( determinant == 0 )
+    {
+        return std::nullopt;
+    }
+    const auto x = point.value( 0 ) - c.value( 0 );
+    const auto y = point.value( 1 ) - c.value( 1 );
+    const auto lambda_a = ( ( b.value( 1 ) - c.value( 1 ) ) * x
+                              + ( c.value( 0 ) - b.value( 0 ) ) * y )
+                          / determinant;
+    const auto lambda_b = ( ( c.value( 1 ) - a.value( 1 ) ) * x
+                              + ( a.value( 0 ) - c.value( 0 ) ) * y )
+                          / determinant;
+    const std::array< double, 3 > lambdas{ lambda_a, lambda_b,
+        1 - lambda_a - lambda_b };
+    for( const auto lambda : lambdas )
+    {
+        if( lambda < -1e-9 )
+        {
+            return std::nullopt;
+        }
+    }
+    return lambdas;
+}
+
+// Sampled raster pixels are located in the triangles covering them in the
+// horizontal plane, and compared to the elevation of the TIN there
+void check_vertical_error( const geode::PolygonalSurface3D& raster,
+    const geode::TriangulatedSurface3D& tin,
+    double max_vertical_error )
+{
+    static constexpr geode::index_t PIXEL_SAMPLING{ 7 };
+    static constexpr double ELEVATION_TOLERANCE{ 1e-3 };
+    std::vector< geode::Point3D > pixels;
+    for( geode::index_t v = 0; v < raster.nb_vertices(); v += PIXEL_SAMPLING )
+    {
+        pixels.push_back( raster.point( v ) );
+    }
+    const HorizontalBuckets buckets{ std::move( pixels ) };
+    std::vector< bool > is_located( buckets.nb_points(), false );
+    for( const auto triangle : geode::Range{ tin.nb_polygons() } )
+    {
+        const auto points = triangle_points( tin, triangle );
+        std::array< double, 2 > box_min{ { INFINITY, INFINITY } };
+        std::array< double, 2 > box_max{ { -INFINITY, -INFINITY } };
+        for( const auto& point : points )
+        {
+            for( const auto d : geode::LRange{ 2 } )
+            {
+                box_min[d] = std::min( box_min[d], point.value( d ) );
+                box_max[d] = std::max( box_max[d], point.value( d ) );
+            }
+        }
+        buckets.for_each_point_near(
+            box_min, box_max, [&]( geode::index_t p ) {
+                const auto& pixel = buckets.point( p );
+                const auto lambdas =
+                    horizontal_barycentric_coordinates( pixel, points );
+                if( !lambdas )
+                {
+                    return;
+                }
+                is_located[p] = true;
+                double elevation{ 0 };
+                for( const auto v : geode::LRange{ 3 } )
+                {
+                    elevation += lambdas.value()[v] * points[v].value( 2 );
+                }
+                geode::OpenGeodeGeosciencesIOMeshException::test(
+                    std::fabs( elevation - pixel.value( 2 ) )
+                        <= max_vertical_error + ELEVATION_TOLERANCE,
+                    "TIN elevation ", elevation, " too far from pixel ",
+                    pixel.string() );
+            } );
+    }
+    const auto nb_located =
+        static_cast< geode::index_t >( absl::c_count( is_located, true ) );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        2 * nb_located > buckets.nb_points(),
+        "Too few raster pixels located in the TIN" );
+}
+
+// Edges are shared by at most two triangles, and border edges, on the
+// raster border or around holes, never contain a vertex: that would be a
+// hanging vertex of triangles splitting the other side of the edge.
+void check_conformity( const geode::TriangulatedSurface3D& tin )
+{
+    absl::flat_hash_map< std::pair< geode::index_t, geode::index_t >,
+        geode::index_t >
+        edge_triangles;
+    for( const auto triangle : geode::Range{ tin.nb_polygons() } )
+    {
+        for( const auto e : geode::LRange{ 3 } )
+        {
+            const auto v0 = tin.polygon_vertex( { triangle, e } );
+            const auto v1 = tin.polygon_vertex(
+                { triangle, static_cast< geode::local_index_t >(
+                                ( e + 1 ) % 3 ) } );
+            edge_triangles[{ std::min( v0, v1 ), std::max( v0, v1 ) }]++;
+        }
+    }
+    std::vector< std::pair< geode::index_t, geode::index_t > > border_edges;
+    absl::flat_hash_set< geode::index_t > border_vertices;
+    std::vector< geode::index_t > border_vertex_ids;
+    std::vector< geode::Point3D > border_points;
+    for( const auto& [edge, nb_triangles] : edge_triangles )
+    {
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            nb_triangles <= 2, "TIN edge shared by more than two triangles" );
+        if( nb_triangles != 1 )
+        {
+            continue;
+        }
+        border_edges.push_back( edge );
+        for( const auto vertex : { edge.first, edge.second } )
+        {
+            if( border_vertices.insert( vertex ).second )
+            {
+                border_vertex_ids.push_back( vertex );
+                border_points.push_back( tin.point( vertex ) );
+            }
+        }
+    }
+    const HorizontalBuckets buckets{ std::move( border_points ) };
+    for( const auto& [v0, v1] : border_edges )
+    {
+        const auto& a = tin.point( v0 );
+        const auto& b = tin.point( v1 );
+        const auto ab_x = b.value( 0 ) - a.value( 0 );
+        const auto ab_y = b.value( 1 ) - a.value( 1 );
+        const auto length2 = ab_x * ab_x + ab_y * ab_y;
+        buckets.for_each_point_near(
+            { std::min( a.value( 0 ), b.value( 0 ) ),
+                std::min( a.value( 1 ), b.value( 1 ) ) },
+            { std::max( a.value( 0 ), b.value( 0 ) ),
+                std::max( a.value( 1 ), b.value( 1 ) ) },
+            [&]( geode::index_t p ) {
+                const auto vertex = border_vertex_ids[p];
+                if( vertex == v0 || vertex == v1 )
+                {
+                    return;
+                }
+                const auto& point = buckets.point( p );
+                const auto ap_x = point.value( 0 ) - a.value( 0 );
+                const auto ap_y = point.value( 1 ) - a.value( 1 );
+                const auto cross = ab_x * ap_y - ab_y * ap_x;
+                const auto dot = ab_x * ap_x + ab_y * ap_y;
+                geode::OpenGeodeGeosciencesIOMeshException::test(
+                    std::fabs( cross ) > 1e-9 * length2 || dot <= 0
+                        || dot >= length2,
+                    "Hanging TIN vertex ", vertex, " on border edge ", v0,
+                    "-", v1 );
+            } );
+    }
+}
+
+void test_tin( const geode::PolygonalSurface3D& raster )
+{
+    const auto filename =
+        absl::StrCat( geode::DATA_PATH, "bathy_IrishSea_DEM.dem" );
+    const auto exact_surface =
+        geode::load_triangulated_surface< 3 >( filename );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        exact_surface->nb_vertices() <= 456427,
+        "Number of vertices in the loaded TIN is not correct" );
+    geode::internal::DEMTINInputOptions options;
+    options.max_vertical_error = 1;
+    geode::internal::DEMTINInput input{ filename, options };
+    const auto surface =
+        input.read( geode::OpenGeodeTriangulatedSurface3D::impl_name_static() );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        surface->nb_vertices() > 0
+            && surface->nb_vertices() < exact_surface->nb_vertices(),
+        "Number of vertices in the simplified TIN is not correct" );
+    geode::Logger::info( "DEM TIN with 1m error: ", surface->nb_vertices(),
+        " vertices, ", surface->nb_polygons(), " triangles" );
+    check_vertical_error( raster, *surface, options.max_vertical_error );
+    check_conformity( *surface );
+}
 
 int main()
 {
@@ -49,6 +348,7 @@ int main()
             "Number of polygons in the loaded Surface is not correct" );
         geode::save_polygonal_surface(
             *surface, "bathy_IrishSea_DEM.og_psf3d" );
+        test_tin( *surface );
 
         geode::Logger::info( "[TEST SUCCESS]" );
 
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/tests_config.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include <geode/basic/assert.hpp>
+#include <geode/basic/attribute_manager.hpp>
+#include <geode/basic/logger.hpp>
+#include <geode/basic/range.hpp>
+
+#include <geode/mesh/core/geode/geode_hybrid_solid.hpp>
+#include <geode/mesh/core/hybrid_solid.hpp>
+#include <geode/mesh/io/hybrid_solid_input.hpp>
+
+#include <geode/geosciences_io/mesh/internal/egrid_input.hpp>
+
+constexpr geode::index_t NX{ 3 };
+constexpr geode::index_t NY{ 2 };
+constexpr geode::index_t NZ{ 2 };
+constexpr geode::index_t NB_CELLS{ NX * NY * NZ };
+// Smaller than the 1000 values used by Eclipse to test split arrays
+constexpr geode::index_t VALUES_PER_RECORD{ 10 };
+
+// Writes synthetic Eclipse binary files: big-endian Fortran records
+class EclipseBinaryWriter
+{
+public:
+    explicit EclipseBinaryWriter( const std::string& filename )
+        : file_{ filename, std::ios::binary }
+    {
+    }
+
+    void write_integers( std::string_view keyword,
+        const std::vector< std::int32_t >& values,
+        std::string_view type = "INTE" )
+    {
+        write_header( keyword, values.size(), type );
+        write_data( values.size(), 4, [&values]( std::size_t id ) {
+            return std::uint64_t{ static_cast< std::uint32_t >(
+                values[id] ) };
+        } );
+    }
+
+    void write_reals(
+        std::string_view keyword, const std::vector< float >& values )
+    {
+        write_header( keyword, values.size(), "REAL" );
+        write_data( values.size(), 4, [&values]( std::size_t id ) {
+            std::uint32_t bits;
+            std::memcpy( &bits, &values[id], sizeof( bits ) );
+            return std::uint64_t{ bits };
+        } );
+    }
+
+    // Writes an empty data record before the values, as in a corrupted file
+    void write_reals_after_empty_record(
+        std::string_view keyword, const std::vector< float >& values )
+    {
+        write_header( keyword, values.size(), "REAL" );
+        write_size( 0 );
+        write_size( 0 );
+        write_data( values.size(), 4, [&values]( std::size_t id ) {
+            std::uint32_t bits;
+            std::memcpy( &bits, &values[id], sizeof( bits ) );
+            return std::uint64_t{ bits };
+        } );
+    }
+
+    void write_doubles(
+        std::string_view keyword, const std::vector< double >& values )
+    {
+        write_header( keyword, values.size(), "DOUB" );
+        write_data( values.size(), 8, [&values]( std::size_t id ) {
+            std::uint64_t bits;
+            std::memcpy( &bits, &values[id], sizeof( bits ) );
+            return bits;
+        } );
+    }
+
+    void write_string( std::string_view keyword, std::string_view value )
+    {
+        write_header( keyword, 1, "CHAR" );
+        write_size( 8 );
+        write_padded( value, 8 );
+        write_size( 8 );
+    }
+
+private:
+    void write_header( std::string_view keyword,
+        std::size_t nb_values,
+        std::string_view type )
+    {
+        write_size( 16 );
+        write_padded( keyword, 8 );
+        write_big_endian( nb_values, 4 );
+        write_padded( type, 4 );
+        write_size( 16 );
+    }
+
+    template < typename Bits >
+    void write_data(
+        std::size_t nb_values, std::size_t value_size, Bits&& bits )
+    {
+        for( std::size_t first = 0; first < nb_values;
+             first += VALUES_PER_RECORD )
+        {
+            const auto last =
+                std::min( first + VALUES_PER_RECORD, nb_values );
+            write_size( ( last - first ) * value_size );
+            for( auto id = first; id < last; id++ )
+            {
+                write_big_endian( bits( id ), value_size );
+            }
+            write_size( ( last - first ) * value_size );
+        }
+    }
+
+    void write_size( std::size_t size )
+    {
+        write_big_endian( size, 4 );
+    }
+
+    void write_padded( std::string_view text, std::size_t size )
+    {
+        std::string padded{ text };
+        padded.resize( size, ' ' );
+        file_.write( padded.data(), size );
+    }
+
+    void write_big_endian( std::uint64_t value, std::size_t nb_bytes )
+    {
+        for( auto shift = 8 * nb_bytes; shift > 0; shift -= 8 )
+        {
+            file_.put(
+                static_cast< char >( ( value >> ( shift - 8 ) ) & 0xFF ) );
+        }
+    }
+
+private:
+    std::ofstream file_;
+};
+
+void write_egrid( const std::string& filename, bool with_empty_record = false )
+{
+    EclipseBinaryWriter writer{ filename };
+    writer.write_integers( "FILEHEAD", std::vector< std::int32_t >( 100 ) );
+    std::vector< std::int32_t > grid_header( 100 );
+    grid_header[0] = 1;
+    grid_header[1] = NX;
+    grid_header[2] = NY;
+    grid_header[3] = NZ;
+    writer.write_integers( "GRIDHEAD", grid_header );
+    std::vector< float > coordinates;
+    for( const auto j : geode::Range{ NY + 1 } )
+    {
+        for( const auto i : geode::Range{ NX + 1 } )
+        {
+            for( const auto z : { 0., 100. } )
+            {
+                coordinates.push_back( 10. * i );
+                coordinates.push_back( 10. * j );
+                coordinates.push_back( z );
+            }
+        }
+    }
+    if( with_empty_record )
+    {
+        writer.write_reals_after_empty_record( "COORD", coordinates );
+    }
+    else
+    {
+        writer.write_reals( "COORD", coordinates );
+    }
+    std::vector< float > depths;
+    for( const auto k : geode::Range{ NZ } )
+    {
+        for( const auto layer : geode::Range{ 2 } )
+        {
+            depths.insert( depths.end(), 4 * NX * NY, 10. * ( k + layer ) );
+        }
+    }
+    writer.write_reals( "ZCORN", depths );
+    std::vector< std::int32_t > active_cells( NB_CELLS, 1 );
+    active_cells[0] = 0;
+    writer.write_integers( "ACTNUM", active_cells );
+    writer.write_integers( "ENDGRID", {} );
+}
+
+void write_init( const std::string& filename )
+{
+    EclipseBinaryWriter writer{ filename };
+    writer.write_integers( "INTEHEAD", std::vector< std::int32_t >( 95 ) );
+    writer.write_integers( "LOGIHEAD",
+        std::vector< std::int32_t >( NB_CELLS, 1 ), "LOGI" );
+    writer.write_string( "TITLE", "TEST" );
+    std::vector< float > pore_volumes( NB_CELLS );
+    for( const auto cell : geode::Range{ NB_CELLS } )
+    {
+        pore_volumes[cell] = cell;
+    }
+    writer.write_reals( "PORV", pore_volumes );
+    std::vector< double > porosities( NB_CELLS - 1 );
+    for( const auto id : geode::Indices{ porosities } )
+    {
+        porosities[id] = 0.1 * ( id + 1 );
+    }
+    writer.write_doubles( "PORO", porosities );
+}
+
+void check_property( const geode::HybridSolid3D& solid,
+    std::string_view name,
+    geode::index_t polyhedron,
+    double value )
+{
+    const auto attribute =
+        solid.polyhedron_attribute_manager().find_attribute< double >(
+            name );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        attribute->value( polyhedron ) == value, "Wrong ", name,
+        " value for polyhedron ", polyhedron );
+}
+
+void check_solid( const geode::HybridSolid3D& solid,
+    geode::index_t nb_polyhedra,
+    geode::index_t nb_vertices )
+{
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        solid.nb_polyhedra() == nb_polyhedra,
+        "Number of polyhedra in the EGRID HybridSolid is not correct" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        solid.nb_vertices() == nb_vertices,
+        "Number of vertices in the EGRID HybridSolid is not correct" );
+    for( const auto polyhedron : geode::Range{ solid.nb_polyhedra() } )
+    {
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            solid.polyhedron_volume( polyhedron ) > 0.,
+            "Found negative volume of polyhedron" );
+    }
+}
+
+void test_egrid()
+{
+    const std::string filename{ "test_output.egrid" };
+    write_egrid( filename );
+    write_init( "test_output.init" );
+
+    const auto solid = geode::load_hybrid_solid< 3 >( filename );
+    check_solid( *solid, NB_CELLS, ( NX + 1 ) * ( NY + 1 ) * ( NZ + 1 ) );
+    check_property( *solid, "ACTNUM", 0, 0 );
+    check_property( *solid, "ACTNUM", 1, 1 );
+    check_property( *solid, "PORV", 5, 5 );
+    check_property( *solid, "PORO", 0, 0 );
+    check_property( *solid, "PORO", 1, 0.1 );
+    check_property( *solid, "PORO", NB_CELLS - 1, 0.1 * ( NB_CELLS - 1 ) );
+    const auto& attribute_manager = solid->polyhedron_attribute_manager();
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        !attribute_manager.attribute_exists( "LOGIHEAD" )
+            && !attribute_manager.attribute_exists( "INTEHEAD" ),
+        "Header arrays should not be imported as properties" );
+
+    const geode::internal::EGRIDInput input{ filename };
+    const auto grid = input.read_corner_point_grid();
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        grid.nb_active_cells() == NB_CELLS - 1,
+        "Wrong number of active cells in the EGRID grid" );
+    const auto active_solid = grid.hybrid_solid(
+        geode::OpenGeodeHybridSolid3D::impl_name_static(), true );
+    check_solid( *active_solid, NB_CELLS - 1,
+        ( NX + 1 ) * ( NY + 1 ) * ( NZ + 1 ) - 1 );
+    check_property( *active_solid, "PORO", 0, 0.1 );
+}
+
+void test_empty_record()
+{
+    const std::string filename{ "test_empty_record.egrid" };
+    write_egrid( filename, true );
+    bool is_rejected{ false };
+    try
+    {
+        geode::load_hybrid_solid< 3 >( filename );
+    }
+    catch( const geode::OpenGeodeException& )
+    {
+        is_rejected = true;
+    }
+    geode::OpenGeodeGeosciencesIOMeshException::test( is_rejected,
+        "[TEST] Empty data record should be rejected" );
+}
+int main()
+{
+    try
+    {
+        geode::OpenGeodeGeosciencesIOMeshLibrary::initialize();
+        test_egrid();
+        test_empty_record();
+        geode::Logger::info( "[TEST SUCCESS]" );
+
+        return 0;
+    }
+    catch( ... )
+    {
+        return geode::geode_lippincott();
+    }
+}
@@ -21,10 +21,15 @@
  *
  */
 
+#include <cmath>
+#include <cstdint>
+
 #include <geode/tests_config.hpp>
 
 #include <geode/basic/assert.hpp>
+#include <geode/basic/attribute_manager.hpp>
 #include <geode/basic/logger.hpp>
+#include <geode/basic/range.hpp>
 
 #include <geode/mesh/core/light_regular_grid.hpp>
 
@@ -32,8 +37,191 @@
 #include <geode/mesh/io/light_regular_grid_output.hpp>
 
 #include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/geotiff_input.hpp>
+#include <geode/geosciences_io/mesh/internal/geotiff_output.hpp>
 #include <geode/io/mesh/common.hpp>
 
+void test_window( const geode::LightRegularGrid2D& grid )
+{
+    geode::internal::GEOTIFFInputOptions options;
+    options.window.cells = { { { 10, 20 }, { 110, 70 } } };
+    options.window.stride = 4;
+    geode::internal::GEOTIFFInput input{
+        absl::StrCat( geode::DATA_PATH, "cea.tiff" ), options
+    };
+    const auto window = input.read();
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        window.nb_cells_in_direction( 0 ) == 25
+            && window.nb_cells_in_direction( 1 ) == 12,
+        "[TEST] Wrong number of cells in the raster window" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        std::fabs( window.cell_length_in_direction( 0 )
+                   - 4 * grid.cell_length_in_direction( 0 ) )
+            < geode::GLOBAL_EPSILON,
+        "[TEST] Wrong cell length in the raster window" );
+}
+
+void test_level( const geode::LightRegularGrid2D& grid )
+{
+    geode::internal::GEOTIFFInputOptions options;
+    options.level.resolution = 16 * grid.cell_length_in_direction( 0 );
+    geode::internal::GEOTIFFInput input{
+        absl::StrCat( geode::DATA_PATH, "cea.tiff" ), options
+    };
+    const auto preview = input.read();
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        preview.nb_cells_in_direction( 0 ) == 32
+            && preview.nb_cells_in_direction( 1 ) == 32,
+        "[TEST] Wrong number of cells in the raster preview" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        std::fabs( preview.cell_length_in_direction( 0 ) * 32
+                   - grid.cell_length_in_direction( 0 ) * 514 )
+            < geode::GLOBAL_EPSILON,
+        "[TEST] Wrong cell length in the raster preview" );
+}
+
+void test_band_attributes()
+{
+    const auto filename = absl::StrCat( geode::DATA_PATH, "cea.tiff" );
+    geode::internal::GEOTIFFInputOptions options;
+    options.band_attributes = true;
+    geode::internal::GEOTIFFInput input{ filename, options };
+    const auto grid = input.read();
+    const auto band_name =
+        geode::internal::GEOTIFFBandReader::attribute_name( 0 );
+    const auto band =
+        grid.cell_attribute_manager().find_attribute< std::uint8_t >(
+            band_name );
+    options.lazy_bands = true;
+    geode::internal::GEOTIFFInput lazy_input{ filename, options };
+    auto lazy_grid = lazy_input.read();
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        lazy_grid.nb_cells() == grid.nb_cells()
+            && lazy_grid.cell_attribute_manager().attribute_names().empty(),
+        "[TEST] Lazy grid should only contain the geometry" );
+    geode::internal::GEOTIFFBandReader reader{ filename, options };
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        reader.nb_bands() == 1, "[TEST] Wrong number of bands" );
+    for( const auto cell : { geode::index_t{ 0 }, geode::index_t{ 12345 },
+             grid.nb_cells() - 1 } )
+    {
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            reader.value( 0, cell ) == band->value( cell ),
+            "[TEST] Wrong lazy band value at cell ", cell );
+    }
+    reader.materialize( 0, lazy_grid );
+    const auto materialized =
+        lazy_grid.cell_attribute_manager().find_attribute< std::uint8_t >(
+            band_name );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        materialized->value( 12345 ) == band->value( 12345 ),
+        "[TEST] Wrong materialized band value" );
+
+    geode::internal::GEOTIFFOutput{ "test_band_levels.tif" }.write( grid );
+    geode::internal::GEOTIFFInputOptions level_options;
+    level_options.band_attributes = true;
+    level_options.level.overview = 1;
+    geode::internal::GEOTIFFInput level_input{ "test_band_levels.tif",
+        level_options };
+    const auto level_grid = level_input.read();
+    const auto level_band =
+        level_grid.cell_attribute_manager().find_attribute< std::uint8_t >(
+            band_name );
+    level_options.lazy_bands = true;
+    geode::internal::GEOTIFFBandReader level_reader{ "test_band_levels.tif",
+        level_options };
+    for( const auto cell : { geode::index_t{ 0 }, level_grid.nb_cells() / 2,
+             level_grid.nb_cells() - 1 } )
+    {
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            level_reader.value( 0, cell ) == level_band->value( cell ),
+            "[TEST] Wrong lazy band value at cell ", cell, " of overview 1" );
+    }
+
+    options.level.resolution = 16 * grid.cell_length_in_direction( 0 );
+    geode::internal::GEOTIFFBandReader resampled_reader{ filename, options };
+    bool is_rejected{ false };
+    try
+    {
+        resampled_reader.value( 0, 0 );
+    }
+    catch( const geode::OpenGeodeException& )
+    {
+        is_rejected = true;
+    }
+    geode::OpenGeodeGeosciencesIOMeshException::test( is_rejected,
+        "[TEST] Lazy values should be rejected at a level without overview" );
+}
+
+void test_output()
+{
+    const auto filename = absl::StrCat( geode::DATA_PATH, "cea.tiff" );
+    geode::internal::GEOTIFFInputOptions input_options;
+    input_options.band_attributes = true;
+    geode::internal::GEOTIFFInput input{ filename, input_options };
+    const auto grid = input.read();
+    geode::internal::GEOTIFFOutputOptions output_options;
+    output_options.compression = "LZW";
+    geode::internal::GEOTIFFOutput output{ "test_output.tif",
+        output_options };
+    output.write( grid );
+    geode::internal::GEOTIFFInput written_input{ "test_output.tif",
+        input_options };
+    const auto written = written_input.read();
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        written.nb_cells_in_direction( 0 ) == grid.nb_cells_in_direction( 0 )
+            && written.nb_cells_in_direction( 1 )
+                   == grid.nb_cells_in_direction( 1 ),
+        "[TEST] Wrong number of cells in the written raster" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        written.origin().inexact_equal( grid.origin() ),
+        "[TEST] Wrong origin of the written raster" );
+    const auto band_name =
+        geode::internal::GEOTIFFBandReader::attribute_name( 0 );
+    const auto band =
+        grid.cell_attribute_manager().find_attribute< std::uint8_t >(
+            band_name );
+    const auto written_band =
+        written.cell_attribute_manager().find_attribute< std::uint8_t >(
+            band_name );
+    for( const auto cell : geode::Range{ grid.nb_cells() } )
+    {
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            written_band->value( cell ) == band->value( cell ),
+            "[TEST] Wrong written band value at cell ", cell );
+    }
+    input_options.gdal.num_threads = "ALL_CPUS";
+    input_options.gdal.cache_max = 64;
+    geode::internal::GEOTIFFInput threaded_input{ "test_output.tif",
+        input_options };
+    const auto threaded = threaded_input.read();
+    const auto threaded_band =
+        threaded.cell_attribute_manager().find_attribute< std::uint8_t >(
+            band_name );
+    for( const auto cell : geode::Range{ grid.nb_cells() } )
+    {
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            threaded_band->value( cell ) == band->value( cell ),
+            "[TEST] Wrong multithreaded band value at cell ", cell );
+    }
+
+    output_options.tile_size = 100;
+    geode::internal::GEOTIFFOutput wrong_tiles_output{
+        "test_output_tiles.tif", output_options
+    };
+    bool is_rejected{ false };
+    try
+    {
+        wrong_tiles_output.write( grid );
+    }
+    catch( const geode::OpenGeodeException& )
+    {
+        is_rejected = true;
+    }
+    geode::OpenGeodeGeosciencesIOMeshException::test( is_rejected,
+        "[TEST] Tile size not multiple of 16 should be rejected" );
+}
+
 int main()
 {
     try
@@ -45,6 +233,10 @@ int main()
         auto grid = geode::load_light_regular_grid< 2 >(
             absl::StrCat( geode::DATA_PATH, "cea.tiff" ) );
         geode::save_light_regular_grid( grid, "cea.vti" );
+        test_window( grid );
+        test_level( grid );
+        test_band_attributes();
+        test_output();
 
         geode::Logger::info( "[TEST SUCCESS]" );
 
@@ -23,11 +23,16 @@
 
 #include <geode/tests_config.hpp>
 
+#include <absl/algorithm/container.h>
+
 #include <geode/basic/assert.hpp>
+#include <geode/basic/attribute_manager.hpp>
 #include <geode/basic/logger.hpp>
 #include <geode/basic/range.hpp>
 
 #include <geode/geosciences_io/mesh/internal/grdecl_input.hpp>
+#include <geode/geosciences_io/mesh/internal/grdecl_output.hpp>
+#include <geode/mesh/builder/hybrid_solid_builder.hpp>
 #include <geode/mesh/core/geode/geode_hybrid_solid.hpp>
 #include <geode/mesh/core/hybrid_solid.hpp>
 #include <geode/mesh/io/hybrid_solid_input.hpp>
@@ -51,12 +56,284 @@ void check_solid( const geode::HybridSolid3D& solid,
     }
 }
 
+void check_adjacencies( geode::HybridSolid3D& solid )
+{
+    std::vector< std::optional< geode::index_t > > adjacents;
+    for( const auto polyhedron : geode::Range{ solid.nb_polyhedra() } )
+    {
+        for( const auto facet :
+            geode::LRange{ solid.nb_polyhedron_facets( polyhedron ) } )
+        {
+            adjacents.push_back(
+                solid.polyhedron_adjacent( { polyhedron, facet } ) );
+        }
+    }
+    geode::HybridSolidBuilder3D::create( solid )
+        ->compute_polyhedron_adjacencies();
+    geode::index_t count{ 0 };
+    for( const auto polyhedron : geode::Range{ solid.nb_polyhedra() } )
+    {
+        for( const auto facet :
+            geode::LRange{ solid.nb_polyhedron_facets( polyhedron ) } )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::test(
+                solid.polyhedron_adjacent( { polyhedron, facet } )
+                    == adjacents[count++],
+                "Wrong adjacency for facet ", facet, " of polyhedron ",
+                polyhedron );
+        }
+    }
+}
+
+void check_property( const geode::HybridSolid3D& solid,
+    std::string_view name,
+    geode::index_t polyhedron,
+    double value )
+{
+    const auto attribute =
+        solid.polyhedron_attribute_manager().find_attribute< double >( name );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        attribute->value( polyhedron ) == value, "Wrong ", name,
+        " value for polyhedron ", polyhedron );
+}
+
 void check_file( std::string_view filename,
     geode::index_t nb_polyhedra,
     geode::index_t nb_vertices )
 {
-    const auto solid = geode::load_hybrid_solid< 3 >( filename );
+    auto solid = geode::load_hybrid_solid< 3 >( filename );
     check_solid( *solid, nb_polyhedra, nb_vertices );
+    check_adjacencies( *solid );
+}
+
+std::unique_ptr< geode::HybridSolid3D > load_active_cells(
+    std::string_view filename )
+{
+    geode::internal::GRDECLInputOptions options;
+    options.skip_inactive_cells = true;
+    geode::internal::GRDECLInput input{ filename, options };
+    return input.read( geode::OpenGeodeHybridSolid3D::impl_name_static() );
+}
+
+void test_inactive_cells()
+{
+    const auto full_solid = load_active_cells( absl::StrCat(
+        geode::DATA_PATH, "Simple20x20x5_Fault.",
+        geode::internal::GRDECLInput::extension() ) );
+    check_solid( *full_solid, 20 * 20 * 5, 21 * 6 * ( 21 + 1 ) );
+
+    auto solid = load_active_cells(
+        absl::StrCat( geode::DATA_PATH, "ActiveCells.",
+            geode::internal::GRDECLInput::extension() ) );
+    check_solid( *solid, 17, 47 );
+    check_adjacencies( *solid );
+    const auto grid_coordinates =
+        solid->polyhedron_attribute_manager()
+            .find_attribute< std::array< geode::index_t, 3 > >(
+                geode::internal::GRDECLInput::
+                    grid_coordinates_attribute_name() );
+    const std::array< geode::index_t, 3 > first_cell{ 1, 0, 0 };
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        grid_coordinates->value( 0 ) == first_cell,
+        "Wrong grid coordinates for the first active cell" );
+    const std::array< geode::index_t, 3 > last_cell{ 1, 2, 2 };
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        grid_coordinates->value( 16 ) == last_cell,
+        "Wrong grid coordinates for the last active cell" );
+    check_property( *solid, "PORO", 0, 0.1 );
+    check_property( *solid, "PORO", 5, 0.2 );
+    check_property( *solid, "PORO", 16, 0.3 );
+    check_property( *solid, "NTG", 3, 0.8 );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        !solid->polyhedron_attribute_manager().attribute_exists( "ACTNUM" ),
+        "ACTNUM should not be imported when skipping inactive cells" );
+}
+
+void test_properties()
+{
+    const auto solid = geode::load_hybrid_solid< 3 >(
+        absl::StrCat( geode::DATA_PATH, "EclipseGridTest.",
+            geode::internal::GRDECLInput::extension() ) );
+    check_property( *solid, "LITHOLOGYTYPE", 5, 6 );
+    check_property( *solid, "FACIESASSOCIATION", 7, 20 );
+    check_property( *solid, "AGE", 0, 1 );
+    check_property( *solid, "AGE", 23, 4 );
+
+    const auto compressed_solid = geode::load_hybrid_solid< 3 >(
+        absl::StrCat( geode::DATA_PATH, "EclipseGridTestCompressed.",
+            geode::internal::GRDECLInput::extension() ) );
+    check_solid( *compressed_solid, 24, 60 );
+    check_property( *compressed_solid, "AGE", 0, 1 );
+    check_property( *compressed_solid, "AGE", 23, 4 );
+}
+
+void test_property_records()
+{
+    const geode::internal::GRDECLInput input{ absl::StrCat(
+        geode::DATA_PATH, "PropertyRecords.",
+        geode::internal::GRDECLInput::extension() ) };
+    const auto grid = input.read_corner_point_grid();
+    const auto names = grid.cell_property_names();
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        names.size() == 2 && names[0] == "PORO" && names[1] == "AGE",
+        "Wrong records read as cell properties" );
+    const auto porosity = grid.cell_property( "PORO" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        porosity[5] == 0 && porosity[6] == 0.1 && porosity[23] == 0.3,
+        "Wrong PORO values given for the active cells only" );
+
+    const auto solid = load_active_cells(
+        absl::StrCat( geode::DATA_PATH, "PropertyRecords.",
+            geode::internal::GRDECLInput::extension() ) );
+    check_solid( *solid, 18, 48 );
+    check_property( *solid, "PORO", 0, 0.1 );
+    check_property( *solid, "PORO", 17, 0.3 );
+    check_property( *solid, "AGE", 0, 2 );
+    check_property( *solid, "AGE", 17, 4 );
+}
+
+void test_included_files()
+{
+    const auto solid = geode::load_hybrid_solid< 3 >(
+        absl::StrCat( geode::DATA_PATH, "IncludedGrid.",
+            geode::internal::GRDECLInput::extension() ) );
+    check_solid( *solid, 24, 60 );
+    check_adjacencies( *solid );
+    check_property( *solid, "LITHOLOGYTYPE", 5, 6 );
+    check_property( *solid, "AGE", 0, 1 );
+    check_property( *solid, "AGE", 23, 4 );
+    // ACTNUM and NTG follow ZCORN in its included file
+    check_property( *solid, "NTG", 23, 0.8 );
+    const geode::internal::GRDECLInput input{ absl::StrCat(
+        geode::DATA_PATH, "IncludedGrid.",
+        geode::internal::GRDECLInput::extension() ) };
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        input.read_corner_point_grid().defines_active_cells(),
+        "ACTNUM after an included ZCORN should be read" );
+}
+
+void test_corner_point_grid()
+{
+    const auto filename = absl::StrCat( geode::DATA_PATH, "ActiveCells.",
+        geode::internal::GRDECLInput::extension() );
+    const geode::internal::GRDECLInput input{ filename };
+    const auto grid = input.read_corner_point_grid();
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        grid.nb_cells() == 24, "Wrong number of cells in the grid" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        grid.nb_active_cells() == 17,
+        "Wrong number of active cells in the grid" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        !grid.is_cell_active( 0 ) && grid.is_cell_active( 1 ),
+        "Wrong active cells in the grid" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        grid.cell_property( "NTG" )[3] == 0.8,
+        "Wrong NTG value in the grid" );
+
+    const auto solid = geode::load_hybrid_solid< 3 >( filename );
+    for( const auto cell : geode::Range{ grid.nb_cells() } )
+    {
+        const auto corners = grid.cell_corners( cell );
+        for( const auto v : geode::LRange{ 8 } )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::test(
+                solid->point( solid->polyhedron_vertex( { cell, v } ) )
+                    .inexact_equal( corners[v] ),
+                "Wrong corner computed by the grid" );
+        }
+    }
+    const auto active_solid = grid.hybrid_solid(
+        geode::OpenGeodeHybridSolid3D::impl_name_static(), true );
+    check_solid( *active_solid, 17, 47 );
+    check_property( *active_solid, "PORO", 16, 0.3 );
+}
+
+void test_output()
+{
+    const auto solid = geode::load_hybrid_solid< 3 >(
+        absl::StrCat( geode::DATA_PATH, "EclipseGridTest.",
+            geode::internal::GRDECLInput::extension() ) );
+    const auto output_file = absl::StrCat(
+        "test_output.", geode::internal::GRDECLOutput::extension() );
+    geode::save_hybrid_solid( *solid, output_file );
+    const auto reloaded_solid = geode::load_hybrid_solid< 3 >( output_file );
+    check_solid( *reloaded_solid, 24, 60 );
+    for( const auto polyhedron : geode::Range{ solid->nb_polyhedra() } )
+    {
+        for( const auto v : geode::LRange{ 8 } )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::test(
+                reloaded_solid
+                    ->point( reloaded_solid->polyhedron_vertex(
+                        { polyhedron, v } ) )
+                    .inexact_equal( solid->point(
+                        solid->polyhedron_vertex( { polyhedron, v } ) ) ),
+                "Wrong point written for polyhedron ", polyhedron );
+        }
+    }
+    check_property( *reloaded_solid, "AGE", 0, 1 );
+    check_property( *reloaded_solid, "AGE", 23, 4 );
+
+    const geode::internal::GRDECLInput input{ absl::StrCat(
+        geode::DATA_PATH, "ActiveCells.",
+        geode::internal::GRDECLInput::extension() ) };
+    const auto grid = input.read_corner_point_grid();
+    geode::internal::GRDECLOutputOptions options;
+    options.use_include_files = true;
+    const auto split_file = absl::StrCat(
+        "test_output_split.", geode::internal::GRDECLOutput::extension() );
+    const auto files =
+        geode::internal::write_grdecl( grid, split_file, options );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        files.size() == 6, "Wrong number of written files" );
+    const auto reloaded_grid =
+        geode::internal::GRDECLInput{ split_file }.read_corner_point_grid();
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        absl::c_equal(
+            grid.pillar_coordinates(), reloaded_grid.pillar_coordinates() )
+            && absl::c_equal(
+                grid.corner_depths(), reloaded_grid.corner_depths() ),
+        "Wrong geometry written in the GRDECL files" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        reloaded_grid.nb_active_cells() == 17,
+        "Wrong active cells written in the GRDECL files" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        absl::c_equal( grid.cell_property( "PORO" ),
+            reloaded_grid.cell_property( "PORO" ) ),
+        "Wrong PORO values written in the GRDECL files" );
+}
+
+void test_output_keywords()
+{
+    const geode::internal::GRDECLInput input{ absl::StrCat(
+        geode::DATA_PATH, "ActiveCells.",
+        geode::internal::GRDECLInput::extension() ) };
+    auto grid = input.read_corner_point_grid();
+    std::vector< double > rock_types( grid.nb_cells() );
+    std::vector< double > other_rock_types( grid.nb_cells() );
+    for( const auto cell : geode::Range{ grid.nb_cells() } )
+    {
+        rock_types[cell] = cell % 3;
+        other_rock_types[cell] = cell % 5;
+    }
+    grid.add_cell_property( "rock type", rock_types );
+    grid.add_cell_property( "Rock-Types", other_rock_types );
+    geode::internal::GRDECLOutputOptions options;
+    options.use_include_files = true;
+    const auto filename =
+        absl::StrCat( "a.b_c.", geode::internal::GRDECLOutput::extension() );
+    geode::internal::write_grdecl( grid, filename, options );
+    const auto reloaded_grid =
+        geode::internal::GRDECLInput{ filename }.read_corner_point_grid();
+    const auto names = reloaded_grid.cell_property_names();
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        names.size() == 4 && names[2] == "ROCK_TYP" && names[3] == "ROCK_TY1",
+        "Wrong keywords written for the property names" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        absl::c_equal( reloaded_grid.cell_property( "ROCK_TYP" ), rock_types )
+            && absl::c_equal(
+                reloaded_grid.cell_property( "ROCK_TY1" ), other_rock_types ),
+        "Wrong property values written in files named after a.b_c" );
 }
 
 int main()
@@ -73,6 +350,13 @@ int main()
                         geode::internal::GRDECLInput::extension() ),
 
             24, 60 );
+        test_properties();
+        test_property_records();
+        test_inactive_cells();
+        test_included_files();
+        test_corner_point_grid();
+        test_output();
+        test_output_keywords();
         geode::Logger::info( "[TEST SUCCESS]" );
 
         return 0;
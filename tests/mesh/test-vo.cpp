@@ -29,11 +29,20 @@
 #include <geode/basic/assert.hpp>
 #include <geode/basic/attribute_manager.hpp>
 #include <geode/basic/logger.hpp>
+#include <geode/basic/range.hpp>
+#include <geode/basic/variable_attribute.hpp>
 
+#include <geode/geometry/coordinate_system.hpp>
+#include <geode/geometry/vector.hpp>
+
+#include <geode/mesh/builder/regular_grid_solid_builder.hpp>
+#include <geode/mesh/core/geode/geode_regular_grid_solid.hpp>
 #include <geode/mesh/core/regular_grid_solid.hpp>
 #include <geode/mesh/io/regular_grid_input.hpp>
+#include <geode/mesh/io/regular_grid_output.hpp>
 
 #include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/vo_input.hpp>
 
 void test_grid_input()
 {
@@ -65,6 +74,233 @@ void test_grid_input()
         third_value, " where it should be 7.21909" );
 }
 
+void test_binary_grid_input()
+{
+    const auto grid = geode::load_regular_grid< 3 >(
+        absl::StrCat( geode::DATA_PATH, "test_binary.vo" ) );
+    const auto density =
+        grid->cell_attribute_manager().find_attribute< double >( "density" );
+    const auto facies =
+        grid->cell_attribute_manager().find_attribute< double >( "facies" );
+    for( const auto k : geode::LRange{ 2 } )
+    {
+        for( const auto j : geode::LRange{ 2 } )
+        {
+            for( const auto i : geode::LRange{ 3 } )
+            {
+                const auto value_id = i + 3 * ( j + 2 * k );
+                const auto cell = grid->cell_index( { i, j, k } );
+                geode::OpenGeodeGeosciencesIOMeshException::test(
+                    density->value( cell ) == 0.5 * value_id,
+                    "[TEST] Error in grid attributes, value for attribute "
+                    "'density' at cell [",
+                    i, ",", j, ",", k, "] is ", density->value( cell ) );
+                const auto facies_value =
+                    value_id % 2 == 0 ? value_id : -1. * value_id;
+                geode::OpenGeodeGeosciencesIOMeshException::test(
+                    facies->value( cell ) == facies_value,
+                    "[TEST] Error in grid attributes, value for attribute "
+                    "'facies' at cell [",
+                    i, ",", j, ",", k, "] is ", facies->value( cell ) );
+            }
+        }
+    }
+}
+
+void test_lazy_properties()
+{
+    const auto filename = absl::StrCat( geode::DATA_PATH, "test_binary.vo" );
+    geode::internal::VOInputOptions options;
+    options.load_properties = false;
+    geode::internal::VOInput input{ filename, options };
+    auto grid =
+        input.read( geode::OpenGeodeRegularGrid3D::impl_name_static() );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        grid->nb_cells() == 12
+            && !grid->cell_attribute_manager().attribute_exists( "density" ),
+        "[TEST] Properties should not be read with the grid" );
+
+    geode::internal::VoxetPropertyLoader loader{ filename, *grid };
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        loader.property_names().size() == 2,
+        "[TEST] Wrong number of Voxet properties" );
+    const auto density = loader.property( "density" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        density->value( grid->cell_index( { 2, 1, 1 } ) ) == 5.5,
+        "[TEST] Wrong lazily loaded density value" );
+    loader.set_memory_budget( grid->nb_cells() * sizeof( double ) );
+    const auto facies = loader.property( "facies" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        facies->value( grid->cell_index( { 1, 0, 0 } ) ) == -1,
+        "[TEST] Wrong lazily loaded facies value" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        loader.is_property_loaded( "facies" )
+            && !loader.is_property_loaded( "density" )
+            && !grid->cell_attribute_manager().attribute_exists( "density" ),
+        "[TEST] Least recently used property should have been evicted" );
+
+    const auto ascii_filename = absl::StrCat( geode::DATA_PATH, "test.vo" );
+    geode::internal::VOInput ascii_input{ ascii_filename, options };
+    auto ascii_grid =
+        ascii_input.read( geode::OpenGeodeRegularGrid3D::impl_name_static() );
+    geode::internal::VoxetPropertyLoader ascii_loader{ ascii_filename,
+        *ascii_grid };
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        ascii_loader.property( "random" )->value(
+            ascii_grid->cell_index( { 5, 0, 9 } ) )
+            == 8.95907,
+        "[TEST] Wrong lazily loaded ASCII value" );
+}
+
+void test_window_input()
+{
+    const auto filename = absl::StrCat( geode::DATA_PATH, "test.vo" );
+    const auto grid = geode::load_regular_grid< 3 >( filename );
+    geode::internal::VOInputOptions options;
+    options.window.stride = 2;
+    geode::internal::VOInput input{ filename, options };
+    const auto window =
+        input.read( geode::OpenGeodeRegularGrid3D::impl_name_static() );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        window->nb_cells() == 125
+            && window->cell_length_in_direction( 0 )
+                   == 2 * grid->cell_length_in_direction( 0 ),
+        "[TEST] Wrong decimated grid" );
+    const auto values =
+        grid->cell_attribute_manager().find_attribute< double >( "random" );
+    const auto window_values =
+        window->cell_attribute_manager().find_attribute< double >( "random" );
+    for( const auto cell : geode::Range{ window->nb_cells() } )
+    {
+        const auto indices = window->cell_indices( cell );
+        const auto file_cell = grid->cell_index( { 2 * indices[0] + 1,
+            2 * indices[1] + 1, 2 * indices[2] + 1 } );
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            window_values->value( cell ) == values->value( file_cell ),
+            "[TEST] Wrong decimated value for cell ", cell );
+    }
+
+    geode::internal::VOInputOptions binary_options;
+    binary_options.window.cells = { { { 1, 1, 0 }, { 3, 2, 2 } } };
+    geode::internal::VOInput binary_input{
+        absl::StrCat( geode::DATA_PATH, "test_binary.vo" ), binary_options
+    };
+    const auto binary_window = binary_input.read(
+        geode::OpenGeodeRegularGrid3D::impl_name_static() );
+    const auto density =
+        binary_window->cell_attribute_manager().find_attribute< double >(
+            "density" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        binary_window->nb_cells() == 4
+            && density->value( binary_window->cell_index( { 0, 0, 0 } ) )
+                   == 2
+            && density->value( binary_window->cell_index( { 1, 0, 1 } ) )
+                   == 5.5,
+        "[TEST] Wrong binary window values" );
+}
+
+void test_output()
+{
+    const auto grid = geode::load_regular_grid< 3 >(
+        absl::StrCat( geode::DATA_PATH, "test_binary.vo" ) );
+    const auto files = geode::save_regular_grid( *grid, "test_output.vo" );
+    geode::OpenGeodeGeosciencesIOMeshException::test( files.size() == 3,
+        "[TEST] Wrong number of written files: ", files.size() );
+    const auto reloaded = geode::load_regular_grid< 3 >( "test_output.vo" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        reloaded->nb_cells() == grid->nb_cells(),
+        "[TEST] Wrong number of cells in written grid" );
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        reloaded->origin() == grid->origin(),
+        "[TEST] Wrong origin in written grid" );
+    for( const auto d : geode::LRange{ 3 } )
+    {
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            reloaded->nb_cells_in_direction( d )
+                    == grid->nb_cells_in_direction( d )
+                && reloaded->cell_length_in_direction( d )
+                       == grid->cell_length_in_direction( d ),
+            "[TEST] Wrong axis ", d, " in written grid" );
+    }
+    for( const auto& name : { "density", "facies" } )
+    {
+        const auto attribute =
+            grid->cell_attribute_manager().find_attribute< double >( name );
+        const auto reloaded_attribute =
+            reloaded->cell_attribute_manager().find_attribute< double >(
+                name );
+        for( const auto cell : geode::Range{ grid->nb_cells() } )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::test(
+                reloaded_attribute->value( cell ) == attribute->value( cell ),
+                "[TEST] Wrong value of written attribute '", name,
+                "' at cell ", cell );
+        }
+    }
+}
+
+void test_rotated_output()
+{
+    auto grid = geode::RegularGrid3D::create();
+    const auto origin = geode::Point3D{ { 1000.5, -250, 42 } };
+    const std::array< geode::Vector3D, 3 > directions{
+        geode::Vector3D{ { 3, 4, 0 } }, geode::Vector3D{ { -8, 6, 0 } },
+        geode::Vector3D{ { 0, 0, 2.5 } }
+    };
+    geode::RegularGridBuilder3D::create( *grid )->initialize_grid(
+        origin, { 4, 3, 2 }, directions );
+    auto attribute =
+        grid->cell_attribute_manager()
+            .find_or_create_attribute< geode::VariableAttribute, double >(
+                "rock type", 0 );
+    auto offsets = grid->cell_attribute_manager()
+                       .find_or_create_attribute< geode::VariableAttribute,
+                           std::array< double, 2 > >(
+                           "offset", std::array< double, 2 >{ 0, 0 } );
+    for( const auto cell : geode::Range{ grid->nb_cells() } )
+    {
+        attribute->set_value( cell, cell * 0.5 );
+        offsets->set_value( cell, { cell * 2., -1. * cell } );
+    }
+    geode::save_regular_grid( *grid, "test_rotated_output.vo" );
+    const auto reloaded =
+        geode::load_regular_grid< 3 >( "test_rotated_output.vo" );
+    const auto& coordinate_system = reloaded->grid_coordinate_system();
+    geode::OpenGeodeGeosciencesIOMeshException::test(
+        coordinate_system.origin().inexact_equal( origin ),
+        "[TEST] Wrong origin in written rotated grid" );
+    for( const auto d : geode::LRange{ 3 } )
+    {
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            reloaded->nb_cells_in_direction( d )
+                    == grid->nb_cells_in_direction( d )
+                && coordinate_system.direction( d ).inexact_equal(
+                    directions[d] ),
+            "[TEST] Wrong axis ", d, " in written rotated grid" );
+    }
+    const auto reloaded_attribute =
+        reloaded->cell_attribute_manager().find_attribute< double >(
+            "rock_type" );
+    for( const auto cell : geode::Range{ grid->nb_cells() } )
+    {
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            reloaded_attribute->value( cell ) == cell * 0.5,
+            "[TEST] Wrong value of written attribute 'rock type' at cell ",
+            cell );
+    }
+    const auto& manager = reloaded->cell_attribute_manager();
+    const auto first_offsets = manager.find_attribute< double >( "offset_0" );
+    const auto second_offsets = manager.find_attribute< double >( "offset_1" );
+    for( const auto cell : geode::Range{ grid->nb_cells() } )
+    {
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            first_offsets->value( cell ) == cell * 2.
+                && second_offsets->value( cell ) == -1. * cell,
+            "[TEST] Wrong items of written attribute 'offset' at cell ",
+            cell );
+    }
+}
+
 int main()
 {
     try
@@ -72,6 +308,11 @@ int main()
         geode::OpenGeodeGeosciencesIOMeshLibrary::initialize();
         geode::Logger::set_level( geode::Logger::LEVEL::debug );
         test_grid_input();
+        test_binary_grid_input();
+        test_lazy_properties();
+        test_window_input();
+        test_output();
+        test_rotated_output();
 
         geode::Logger::info( "TEST SUCCESS" );
         return 0;
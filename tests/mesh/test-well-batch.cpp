@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/tests_config.hpp>
+
+#include <algorithm>
+
+#include <geode/basic/assert.hpp>
+#include <geode/basic/attribute_manager.hpp>
+#include <geode/basic/filename.hpp>
+#include <geode/basic/logger.hpp>
+#include <geode/basic/range.hpp>
+
+#include <geode/mesh/core/edged_curve.hpp>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/well_batch_input.hpp>
+
+namespace
+{
+    std::vector< std::string > test_files()
+    {
+        return { absl::StrCat( geode::DATA_PATH, "test.wl" ),
+            absl::StrCat( geode::DATA_PATH, "test_well.dev" ),
+            absl::StrCat( geode::DATA_PATH, "test_well.txt" ),
+            absl::StrCat( geode::DATA_PATH, "test_well.dat" ) };
+    }
+
+    void test_well_files()
+    {
+        const auto files = geode::internal::well_files( geode::DATA_PATH );
+        for( const auto& file : test_files() )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::test(
+                std::find_if( files.begin(), files.end(),
+                    [&file]( const std::string& found ) {
+                        return geode::filename_with_extension( found )
+                               == geode::filename_with_extension( file );
+                    } )
+                    != files.end(),
+                "[TEST] Well file not found in data directory: ", file );
+        }
+    }
+
+    void test_load_wells()
+    {
+        const auto wells = geode::internal::load_wells( test_files() );
+        const std::vector< geode::index_t > nb_vertices{ 55, 104, 11, 11 };
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            wells.size() == nb_vertices.size(),
+            "[TEST] Wrong number of wells" );
+        for( const auto w : geode::Indices{ wells } )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::test(
+                wells[w]->nb_vertices() == nb_vertices[w]
+                    && wells[w]->nb_edges() == nb_vertices[w] - 1,
+                "[TEST] Wrong number of vertices or edges in well ", w );
+        }
+    }
+
+    void test_load_packed_wells()
+    {
+        const auto packed = geode::internal::load_packed_wells( test_files() );
+        const std::vector< geode::index_t > vertex_offsets{ 0, 55, 159, 170,
+            181 };
+        const std::vector< geode::index_t > edge_offsets{ 0, 54, 157, 167,
+            177 };
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            packed.vertex_offsets == vertex_offsets
+                && packed.edge_offsets == edge_offsets,
+            "[TEST] Wrong packed well offsets" );
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            packed.curve->nb_vertices() == 181
+                && packed.curve->nb_edges() == 177,
+            "[TEST] Wrong number of vertices or edges in packed wells" );
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            packed.names[1] == "TEST", "[TEST] Wrong packed well name" );
+        const auto well_ids =
+            packed.curve->vertex_attribute_manager()
+                .find_attribute< geode::index_t >(
+                    geode::internal::PackedWells::WELL_ID_ATTRIBUTE_NAME );
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            well_ids->value( 54 ) == 0 && well_ids->value( 55 ) == 1
+                && well_ids->value( 180 ) == 3,
+            "[TEST] Wrong packed vertex well ids" );
+        const auto& edge = packed.curve->edge_vertices( 54 );
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            edge[0] == 55 && edge[1] == 56,
+            "[TEST] Wrong first edge of the second packed well" );
+        const auto md =
+            packed.curve->vertex_attribute_manager().find_attribute< double >(
+                "MD" );
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            md->value( 0 ) == 0 && md->value( 56 ) > 30
+                && md->value( 56 ) < 30.001,
+            "[TEST] Wrong packed well attribute" );
+    }
+} // namespace
+
+int main()
+{
+    try
+    {
+        geode::OpenGeodeGeosciencesIOMeshLibrary::initialize();
+        test_well_files();
+        test_load_wells();
+        test_load_packed_wells();
+
+        geode::Logger::info( "TEST SUCCESS" );
+        return 0;
+    }
+    catch( ... )
+    {
+        return geode::geode_lippincott();
+    }
+}
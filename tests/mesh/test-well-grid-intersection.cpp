@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2019 - 2026 Geode-solutions
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <geode/tests_config.hpp>
+
+#include <cmath>
+
+#include <geode/basic/assert.hpp>
+#include <geode/basic/attribute_manager.hpp>
+#include <geode/basic/logger.hpp>
+#include <geode/basic/range.hpp>
+
+#include <geode/geometry/point.hpp>
+#include <geode/geometry/vector.hpp>
+
+#include <geode/mesh/builder/edged_curve_builder.hpp>
+#include <geode/mesh/builder/regular_grid_solid_builder.hpp>
+#include <geode/mesh/core/edged_curve.hpp>
+#include <geode/mesh/core/hybrid_solid.hpp>
+#include <geode/mesh/core/regular_grid_solid.hpp>
+#include <geode/mesh/io/hybrid_solid_input.hpp>
+#include <geode/mesh/io/regular_grid_input.hpp>
+
+#include <geode/geosciences_io/mesh/common.hpp>
+#include <geode/geosciences_io/mesh/internal/corner_point_grid.hpp>
+#include <geode/geosciences_io/mesh/internal/well_grid_intersection.hpp>
+
+namespace
+{
+    constexpr double TOLERANCE = 1e-3;
+
+    std::unique_ptr< geode::EdgedCurve3D > create_well(
+        const std::vector< geode::Point3D >& points )
+    {
+        auto well = geode::EdgedCurve3D::create();
+        auto builder = geode::EdgedCurveBuilder3D::create( *well );
+        for( const auto& point : points )
+        {
+            const auto vertex = builder->create_point( point );
+            if( vertex > 0 )
+            {
+                builder->create_edge( vertex - 1, vertex );
+            }
+        }
+        return well;
+    }
+
+    void check_contiguity(
+        absl::Span< const geode::internal::WellCellIntersection >
+            intersections )
+    {
+        for( const auto i : geode::Range{ 1, intersections.size() } )
+        {
+            geode::OpenGeodeGeosciencesIOMeshException::test(
+                intersections[i].entry_depth
+                    == intersections[i - 1].exit_depth,
+                "[TEST] Gap between intersections ", i - 1, " and ", i );
+        }
+    }
+
+    void test_regular_grid()
+    {
+        const auto grid = geode::load_regular_grid< 3 >(
+            absl::StrCat( geode::DATA_PATH, "test.vo" ) );
+        const auto nb_layers = grid->nb_cells_in_direction( 2 );
+        const auto bottom = ( grid->grid_point( { 2, 3, 0 } )
+                                 + grid->grid_point( { 3, 4, 0 } ) )
+                            / 2.;
+        const auto top = ( grid->grid_point( { 2, 3, nb_layers } )
+                              + grid->grid_point( { 3, 4, nb_layers } ) )
+                         / 2.;
+        const auto height = ( top.value( 2 ) - bottom.value( 2 ) ) / nb_layers;
+        const geode::Point3D offset{ { 0, 0, height / 2 } };
+        const auto vertical = create_well( { bottom - offset, top + offset } );
+        const auto intersections =
+            geode::internal::well_cell_intersections( *grid, *vertical );
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            intersections.size() == nb_layers,
+            "[TEST] Wrong number of cells crossed by the vertical well" );
+        for( const auto k : geode::Range{ nb_layers } )
+        {
+            const auto& intersection = intersections[k];
+            geode::OpenGeodeGeosciencesIOMeshException::test(
+                intersection.cell == grid->cell_index( { 2, 3, k } ),
+                "[TEST] Wrong cell crossed by the vertical well in layer ",
+                k );
+            geode::OpenGeodeGeosciencesIOMeshException::test(
+                std::fabs( intersection.length - height ) < TOLERANCE
+                    && std::fabs( intersection.entry_depth
+                                  - ( k + 0.5 ) * height )
+                           < TOLERANCE,
+                "[TEST] Wrong vertical well depths in layer ", k );
+        }
+        check_contiguity( intersections );
+
+        const auto diagonal = create_well( { grid->grid_point( { 1, 2, 0 } )
+                                                 - offset,
+            grid->grid_point( { 9, 7, 4 } ),
+            grid->grid_point( { 3, 9, 10 } ) + offset } );
+        const auto grid_intersections =
+            geode::internal::well_cell_intersections( *grid, *diagonal );
+        check_contiguity( grid_intersections );
+        const auto corner_point_grid =
+            geode::internal::corner_point_grid_from_regular_grid( *grid );
+        const auto pillar_intersections =
+            geode::internal::well_cell_intersections(
+                corner_point_grid, *diagonal );
+        double length{ 0 };
+        for( const auto& intersection : grid_intersections )
+        {
+            length += intersection.length;
+        }
+        double pillar_length{ 0 };
+        for( const auto& intersection : pillar_intersections )
+        {
+            pillar_length += intersection.length;
+        }
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            std::fabs( length - pillar_length ) < TOLERANCE,
+            "[TEST] Different well lengths in the regular and corner-point "
+            "grids" );
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            std::fabs( grid_intersections.front().entry_depth
+                       - pillar_intersections.front().entry_depth )
+                < TOLERANCE,
+            "[TEST] Different well entry depths in the regular and "
+            "corner-point grids" );
+    }
+
+    void test_corner_point_grid()
+    {
+        std::vector< std::unique_ptr< geode::EdgedCurve3D > > wells;
+        // Center line of the first column, whose pillars are slanted
+        wells.push_back(
+            create_well( { geode::Point3D{ { 1035 - 1.025 * 50, 2100, 950 } },
+                geode::Point3D{ { 1035 + 1.025 * 450, 2100, 1450 } } } ) );
+        wells.push_back(
+            create_well( { geode::Point3D{ { 0, 0, 0 } },
+                geode::Point3D{ { 100, 100, 100 } } } ) );
+        const auto solid = geode::load_hybrid_solid< 3 >(
+            absl::StrCat( geode::DATA_PATH, "EclipseGridTest.grdecl" ) );
+        const auto intersections =
+            geode::internal::wells_cell_intersections( *solid, wells );
+        geode::OpenGeodeGeosciencesIOMeshException::test(
+            intersections.size() == 2 && intersections[0].size() == 4
+                && intersections[1].empty(),
+            "[TEST] Wrong number of cells crossed by the wells" );
+        const auto grid_coordinates =
+            solid->polyhedron_attribute_manager()
+                .find_attribute< std::array< geode::index_t, 3 > >(
+                    geode::internal::CornerPointGrid::
+                        grid_coordinates_attribute_name() );
+        const auto cell_length = 100 * std::sqrt( 1 + 1.025 * 1.025 );
+        for( const auto k : geode::Range{ 4 } )
+        {
+            const auto& intersection = intersections[0][k];
+            const std::array< geode::index_t, 3 > expected{ 0, 0, k };
+            geode::OpenGeodeGeosciencesIOMeshException::test(
+                grid_coordinates->value( intersection.cell ) == expected,
+                "[TEST] Wrong polyhedron crossed by the well in layer ", k );
+            geode::OpenGeodeGeosciencesIOMeshException::test(
+                std::fabs( intersection.length - cell_length ) < TOLERANCE,
+                "[TEST] Wrong well length in layer ", k );
+        }
+        check_contiguity( intersections[0] );
+    }
+
+    void test_horizontal_pillars()
+    {
+        auto grid = geode::RegularGrid3D::create();
+        geode::RegularGridBuilder3D::create( *grid )->initialize_grid(
+            geode::Point3D{ { 0, 0, 0 } }, { 2, 2, 2 },
+            { geode::Vector3D{ { 1, 0, 0 } }, geode::Vector3D{ { 0, 0, 1 } },
+                geode::Vector3D{ { 0, 1, 0 } } } );
+        bool is_rejected{ false };
+        try
+        {
+            geode::internal::corner_point_grid_from_regular_grid( *grid );
+        }
+        catch( const geode::OpenGeodeException& )
+        {
+            is_rejected = true;
+        }
+        geode::OpenGeodeGeosciencesIOMeshException::test( is_rejected,
+            "[TEST] Grid with a horizontal third direction should be "
+            "rejected" );
+    }
+} // namespace
+
+int main()
+{
+    try
+    {
+        geode::OpenGeodeGeosciencesIOMeshLibrary::initialize();
+        test_regular_grid();
+        test_corner_point_grid();
+        test_horizontal_pillars();
+
+        geode::Logger::info( "TEST SUCCESS" );
+        return 0;
+    }
+    catch( ... )
+    {
+        return geode::geode_lippincott();
+    }
+}